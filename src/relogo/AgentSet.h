@@ -50,6 +50,7 @@
 #include <limits>
 
 #include "repast_hpc/Random.h"
+#include "repast_hpc/ParallelAgents.h"
 
 namespace repast {
 
@@ -167,6 +168,32 @@ public:
 	template<typename Functor>
 	void apply(const Functor& func);
 
+	/**
+	 * Calls the Functor on each agent in this AgentSet, split across the
+	 * process's threads (see repast::setThreadCount). Inside the called
+	 * method, repast::agentRandom() gives each agent its own random stream,
+	 * so the results do not depend on the thread count. The method must not
+	 * modify state shared between agents; in particular it should record
+	 * moves in a repast::DeferredMoves rather than moving the agent itself.
+	 * See repast::forEachAgentInParallel.
+	 *
+	 * @param func a pointer to the method to call each member of the set
+	 *
+	 * @tparam Functor pointer to no-arg method belonging to the type of agent contained
+	 * by this AgentSet.
+	 */
+	template<typename Functor>
+	void askParallel(Functor func);
+
+	/**
+	 * Applies the functor to each agent in the agent set, split across the
+	 * process's threads. The functor is called concurrently; see askParallel.
+	 *
+	 * @tparam Functor an object that implements operator()(T* agent) const;
+	 */
+	template<typename Functor>
+	void applyParallel(const Functor& func);
+
 	/**
 	 * Gets the item at the specified index.
 	 *
@@ -364,6 +391,18 @@ public:
 //private:
 	std::vector<T*> agents;
 
+	/**
+	 * Adapts a pointer to a no-arg method to a functor for the parallel loop.
+	 */
+	template<typename Functor>
+	struct MethodCaller {
+		Functor func;
+		MethodCaller(Functor method) : func(method) {}
+		void operator()(T* target) const {
+			(target->*func)();
+		}
+	};
+
 };
 
 template<typename T>
@@ -437,6 +476,19 @@ void AgentSet<T>::ask(Functor func) {
 	}
 }
 
+template<typename T>
+template<typename Functor>
+void AgentSet<T>::askParallel(Functor func) {
+	MethodCaller<Functor> caller(func);
+	repast::forEachAgentInParallel(agents, caller);
+}
+
+template<typename T>
+template<typename Functor>
+void AgentSet<T>::applyParallel(const Functor& func) {
+	repast::forEachAgentInParallel(agents, func);
+}
+
 template<typename T>
 template<typename Functor, typename P1>
 void AgentSet<T>::ask(Functor func, const P1& p1) {
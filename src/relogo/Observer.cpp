@@ -45,6 +45,7 @@
 #include "Patch.h"
 #include "repast_hpc/RepastProcess.h"
 #include "repast_hpc/initialize_random.h"
+#include "repast_hpc/initialize_threads.h"
 #include "repast_hpc/Point.h"
 #include "utility.h"
 #include "creators.h"
@@ -63,7 +64,8 @@ const int Observer::NO_TYPE_ID = -1;
 static DefaultLinkCreator _defaultLinkCreator;
 
 Observer::Observer() :
-		context(RepastProcess::instance()->getCommunicator()), rndXP(0), rndYP(0), rndX(0), rndY(0) {
+		context(RepastProcess::instance()->getCommunicator()), rndXP(0), rndYP(0), rndX(0), rndY(0), patchCells(0),
+		bufferSize(0), wrapped(false) {
 	_rank = RepastProcess::instance()->rank();
 }
 
@@ -76,6 +78,23 @@ Observer::~Observer() {
 	for (size_t i = 0; i < dataSets.size(); ++i) {
 		delete dataSets[i];
 	}
+
+	for (size_t i = 0; i < patchVariables.size(); ++i) {
+		delete patchVariables[i];
+	}
+}
+
+BasePatchVariable* Observer::findPatchVariable(const std::string& name) {
+	for (size_t i = 0; i < patchVariables.size(); ++i) {
+		if (patchVariables[i]->name() == name) return patchVariables[i];
+	}
+	return 0;
+}
+
+void Observer::synchronizePatchVariables() {
+	for (size_t i = 0; i < patchVariables.size(); ++i) {
+		patchVariables[i]->synchronize();
+	}
 }
 
 void Observer::dataSetClose() {
@@ -127,6 +146,7 @@ double Observer::randomYcor() {
 void Observer::_setup(Properties& props) {
 	_props = props;
 	repast::initializeRandom(props, RepastProcess::instance()->getCommunicator());
+	repast::initializeThreads(props);
 	ScheduleRunner& runner = RepastProcess::instance()->getScheduleRunner();
 	runner.scheduleEvent(1, 1, Schedule::FunctorPtr(new MethodFunctor<Observer> (this, &Observer::go)));
 	if (props.contains(STOP_AT)) {
@@ -159,6 +179,12 @@ const RelogoSpaceType* Observer::space() {
 	return static_cast<RelogoSpaceType*> (context.getProjection(SPACE_NAME));
 }
 
+bool Observer::spacePtToGridPt(Point<double, 2>& spacePt, Point<int, 2>& gridPt) {
+  gridPt[0] = doubleCoordToInt(spacePt[0]);
+  gridPt[1] = doubleCoordToInt(spacePt[1]);
+  return false;
+}
+
 bool Observer::spacePtToGridPt(std::vector<double>& spacePt, std::vector<int>& gridPt) {
   gridPt[0] = doubleCoordToInt(spacePt[0]);
   gridPt[1] = doubleCoordToInt(spacePt[1]);
@@ -274,6 +300,11 @@ boost::shared_ptr<RelogoLink> Observer::link(RelogoAgent* source, RelogoAgent* t
 }
 
 Patch* Observer::patchAt(int x, int y) {
+	RelogoAgent* patch;
+	if (patchCells != 0 && patchCells->findPatch(x, y, patch)) {
+		return static_cast<Patch*> (patch);
+	}
+
 	vector<RelogoAgent*> out;
 	grid()->getObjectsAt(Point<int> (x, y), out);
 	for (int i = 0, n = out.size(); i < n; i++) {
@@ -55,6 +55,8 @@
 #include "RelogoContinuousSpaceAdder.h"
 #include "RelogoLink.h"
 #include "WorldDefinition.h"
+#include "PatchOccupancy.h"
+#include "PatchVariable.h"
 #include "creators.h"
 #include "relogo.h"
 #include "agent_set_functions.h"
@@ -211,6 +213,13 @@ public:
 	 */
 	bool spacePtToGridPt(std::vector<double>& spacePt, std::vector<int>& gridPt);
 
+	/*
+	 * Fixed dimension version of spacePtToGridPt used when turtles move.
+	 *
+	 * NON API method
+	 */
+	bool spacePtToGridPt(Point<double, 2>& spacePt, Point<int, 2>& gridPt);
+
 	/**
 	 * Hatchs an agent of the specified type. The new agent
 	 * will have the location and heading of the specified "parent".
@@ -594,6 +603,44 @@ public:
 #endif
     );
 
+	/**
+	 * Creates a patch variable with the specified name. The variable holds
+	 * a value of type T for each local patch and for the patches in the buffer
+	 * zone in a contiguous array, and is kept in sync across processes by
+	 * synchronize. Patch variables do not require patch agents, so they
+	 * can be used with worlds whose WorldDefinition skips creating patches.
+	 * The variable is owned by this Observer.
+	 *
+	 * @param name the name of the variable
+	 * @param initialValue the value every patch starts with
+	 *
+	 * @tparam T the type of the variable's values
+	 *
+	 * @return the created variable.
+	 */
+	template<typename T>
+	PatchVariable<T>* createPatchVariable(const std::string& name, T initialValue = T());
+
+	/**
+	 * Gets the patch variable with the specified name.
+	 *
+	 * @param name the name of the variable
+	 *
+	 * @tparam T the type of the variable's values
+	 *
+	 * @return the patch variable with the specified name, or 0 if there is no
+	 * such variable or its values are not of type T.
+	 */
+	template<typename T>
+	PatchVariable<T>* patchVariable(const std::string& name);
+
+	/**
+	 * Copies the values of the local patches in each patch variable into the
+	 * buffer zones of the adjacent processes. This is called by synchronize
+	 * but may be called on its own if only the patch variables have changed.
+	 */
+	void synchronizePatchVariables();
+
 
 protected:
 	typedef SharedNetwork<RelogoAgent, RelogoLink, RelogoLinkContent, RelogoLinkContentManager> NetworkType;
@@ -629,6 +676,19 @@ private:
 	IntUniformGenerator* rndXP, *rndYP;
 	DoubleUniformGenerator* rndX, *rndY;
 
+	// the grid's patches over the local bounds plus the buffer, set by WorldCreator
+	const PatchOccupancy<RelogoAgent, int>* patchCells;
+
+	// the world's geometry that patch variables are laid out over, set by WorldCreator
+	GridDimensions worldBounds;
+	std::vector<int> processDims;
+	int bufferSize;
+	bool wrapped;
+
+	std::vector<BasePatchVariable*> patchVariables;
+
+	BasePatchVariable* findPatchVariable(const std::string& name);
+
 };
 
 template<typename AgentType>
@@ -737,7 +797,7 @@ void Observer::turtlesAt(int x, int y, AgentSet<AgentType>& set) {
 	int typeId = getTypeId<AgentType> ();
 	if (typeId != NO_TYPE_ID) {
 		std::vector<RelogoAgent*> out;
-		grid()->getObjectsAt(Point<int> (x, y), out);
+		grid()->getObjectsAt(Point<int, 2> (x, y), out);
 		filterVecToSet(out, set, typeId);
 	}
 }
@@ -799,7 +859,7 @@ void Observer::turtlesOn(const RelogoAgent* agent, AgentSet<TurtleType>& out) {
   int typeId = getTypeId<TurtleType> ();
 	if (typeId != NO_TYPE_ID) {
 		std::vector<RelogoAgent*> in;
-		grid()->getObjectsAt(Point<int> (agent->pxCor(), agent->pyCor()), in);
+		grid()->getObjectsAt(Point<int, 2> (agent->pxCor(), agent->pyCor()), in);
 		filterVecToSet(in, out, typeId);
 	}
 }
@@ -811,7 +871,7 @@ void Observer::turtlesOn(AgentSet<RelogoAgent>& agentSet, AgentSet<TurtleType>&
 		std::vector<RelogoAgent*> in;
 		for (AgentSet<RelogoAgent>::const_as_iterator iter = agentSet.begin(); iter != agentSet.end(); ++iter) {
 			RelogoAgent* agent = *iter;
-			grid()->getObjectsAt(Point<int> (agent->pxCor(), agent->pyCor()), in);
+			grid()->getObjectsAt(Point<int, 2> (agent->pxCor(), agent->pyCor()), in);
 		}
 		filterVecToSetNoDuplicates(in, out, typeId);
 	}
@@ -861,11 +921,25 @@ void Observer::synchronize(Provider& provider, Updater& updater, AgentCreator& c
   repast::RepastProcess::instance()->synchronizeProjectionInfo<RelogoAgent, TurtleContent, Provider, AgentCreator, Updater>(context, provider, updater, creator, exchangePattern);
 #endif
 
+  synchronizePatchVariables();
 
 //  synchronizeTurtleStates<TurtleContent>(provider, updater);
 }
 
 
+template<typename T>
+PatchVariable<T>* Observer::createPatchVariable(const std::string& name, T initialValue) {
+	if (findPatchVariable(name) != 0) throw ReLogo_Error_5(name); // Patch variable already exists
+	PatchVariable<T>* var = new PatchVariable<T>(name, processDims, worldBounds, bufferSize, wrapped, initialValue);
+	patchVariables.push_back(var);
+	return var;
+}
+
+template<typename T>
+PatchVariable<T>* Observer::patchVariable(const std::string& name) {
+	return dynamic_cast<PatchVariable<T>*> (findPatchVariable(name));
+}
+
 template<typename AgentType>
 AgentType* Observer::who(const AgentId& id) {
 	RelogoAgent* agent = context.getAgent(id);
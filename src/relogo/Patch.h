@@ -125,6 +125,29 @@ public:
 	template<typename PatchType>
 	void neighbors4(AgentSet<PatchType>& out);
 
+	/**
+	 * Gets this patch's value of the specified patch variable.
+	 *
+	 * @param var the patch variable
+	 * @tparam T the type of the variable's values
+	 */
+	template<typename T>
+	T value(PatchVariable<T>* var) const {
+		return var->get(pxCor(), pyCor());
+	}
+
+	/**
+	 * Sets this patch's value of the specified patch variable.
+	 *
+	 * @param var the patch variable
+	 * @param value the new value
+	 * @tparam T the type of the variable's values
+	 */
+	template<typename T>
+	void setValue(PatchVariable<T>* var, typename PatchVariable<T>::value_type value) {
+		var->set(pxCor(), pyCor(), value);
+	}
+
 };
 
 template<typename PatchType>
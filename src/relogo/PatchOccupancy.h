@@ -0,0 +1,201 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  PatchOccupancy.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PATCHOCCUPANCY_H_
+#define PATCHOCCUPANCY_H_
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "repast_hpc/MultipleOccupancy.h"
+#include "relogo.h"
+
+namespace repast {
+namespace relogo {
+
+/**
+ * Multiple occupancy cell accessor for the relogo grid that also keeps the
+ * patch at each location in a dense 2D array, so finding a location's patch
+ * is a bounds checked index rather than a scan of its occupants. The array
+ * covers the bounds passed to init, i.e. the local bounds plus the buffer.
+ * It is kept up to date as patches are put and removed, so it follows
+ * patch creation by WorldCreator as well as the buffer zone patches placed
+ * and dropped by synchronization.
+ *
+ * Occupants other than patches, and the order getAll returns occupants in,
+ * are left to a MultipleOccupancy.
+ *
+ * @tparam T the type of object in the grid
+ * @tparam GPType the coordinate type of the grid point locations
+ */
+template<typename T, typename GPType>
+class PatchOccupancy {
+
+public:
+
+	/**
+	 * The type of point locations are keyed on.
+	 */
+	typedef typename MultipleOccupancy<T, GPType>::PointType PointType;
+
+private:
+	MultipleOccupancy<T, GPType> occupants;
+	std::vector<T*> patches;
+	GPType originX, originY, width, height;
+
+	// the index of the location's patch slot or -1 if it is outside the array
+	int index(GPType x, GPType y) const {
+		GPType col = x - originX, row = y - originY;
+		if (col < 0 || col >= width || row < 0 || row >= height) return -1;
+		return (int) (row * width + col);
+	}
+
+	template<std::size_t M>
+	int index(const Point<GPType, M>& location) const {
+		return location.dimensionCount() == 2 ? index(location[0], location[1]) : -1;
+	}
+
+public:
+
+	PatchOccupancy() :
+			originX(0), originY(0), width(0), height(0) {
+	}
+
+	/**
+	 * Sizes the patch array to cover the specified bounds.
+	 *
+	 * @param bounds the bounds to hold in the patch array
+	 */
+	void init(const GridDimensions& bounds) {
+		originX = (GPType) bounds.origin(0);
+		originY = (GPType) bounds.origin(1);
+		width = (GPType) bounds.extents(0);
+		height = (GPType) bounds.extents(1);
+		patches.assign(width * height, 0);
+	}
+
+	/**
+	 * Finds the patch at the specified location.
+	 *
+	 * @param x the x coordinate of the location
+	 * @param y the y coordinate of the location
+	 * @param [out] patch set to the patch at the location, or 0 if there is none
+	 *
+	 * @return true if the location is within the patch array, otherwise
+	 * false and patch is left unset.
+	 */
+	bool findPatch(GPType x, GPType y, T*& patch) const {
+		int i = index(x, y);
+		if (i < 0) return false;
+		patch = patches[i];
+		return true;
+	}
+
+	/**
+	 * Gets the first object found at the specified location.
+	 *
+	 * @param location the location to get the object at
+	 * @return the first object found at the specified location or 0 if there
+	 * are no objects at the specified location.
+	 */
+	template<std::size_t M>
+	T* get(const Point<GPType, M>& location) const {
+		return occupants.get(location);
+	}
+
+	/**
+	 * Gets all the items found at the specified location.
+	 *
+	 * @param location the location to get the items at
+	 * @param [out] the found items will be returned in this vector
+	 */
+	template<std::size_t M>
+	void getAll(const Point<GPType, M>& location, std::vector<T*>& out) const {
+		occupants.getAll(location, out);
+	}
+
+	/**
+	 * Puts the specified item at the specified location.
+	 *
+	 * @param agent the item to put
+	 * @param location the location to put the item at
+	 */
+	template<std::size_t M>
+	bool put(boost::shared_ptr<T>& agent, const Point<GPType, M>& location) {
+		if (!occupants.put(agent, location)) return false;
+		if (agent->getId().agentType() == PATCH_TYPE_ID) {
+			int i = index(location);
+			if (i >= 0 && patches[i] == 0) patches[i] = agent.get();
+		}
+		return true;
+	}
+
+	/**
+	 * Removes the specified item from the specified location.
+	 *
+	 * @param agent the item to remove
+	 * @param location the location to remove the item from
+	 */
+	template<std::size_t M>
+	void remove(boost::shared_ptr<T>& agent, const Point<GPType, M>& location) {
+		occupants.remove(agent, location);
+		int i = index(location);
+		if (i >= 0 && patches[i] == agent.get()) {
+			// patches pass through the adder's location on their way to their
+			// own, so another patch may still be here
+			patches[i] = 0;
+			std::vector<T*> remaining;
+			occupants.getAll(location, remaining);
+			for (size_t j = 0; j < remaining.size(); j++) {
+				if (remaining[j]->getId().agentType() == PATCH_TYPE_ID) {
+					patches[i] = remaining[j];
+					break;
+				}
+			}
+		}
+	}
+
+};
+
+}
+}
+
+#endif /* PATCHOCCUPANCY_H_ */
@@ -0,0 +1,193 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  PatchVariable.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PATCHVARIABLE_H_
+#define PATCHVARIABLE_H_
+
+#include <string>
+#include <vector>
+
+#include "repast_hpc/ValueLayerND.h"
+
+#include "RelogoErrors.h"
+
+namespace repast {
+namespace relogo {
+
+/**
+ * The part of a PatchVariable that doesn't depend on the value type, so
+ * that an Observer can hold and synchronize variables of any type.
+ */
+class BasePatchVariable {
+
+private:
+	std::string _name;
+
+public:
+	BasePatchVariable(const std::string& name) :
+			_name(name) {
+	}
+
+	virtual ~BasePatchVariable() {
+	}
+
+	/**
+	 * Gets the name of this variable.
+	 */
+	const std::string& name() const {
+		return _name;
+	}
+
+	/**
+	 * Copies the values of the adjacent processes' patches into this
+	 * variable's buffer zone.
+	 */
+	virtual void synchronize() = 0;
+};
+
+/**
+ * A value of type T for every patch, held in a contiguous ValueLayerND
+ * covering this process's patches plus the buffer zone rather than as a
+ * field of each Patch agent. Values are read and written by patch
+ * coordinates; only the local values should be written, and the buffer
+ * zone is refreshed from the adjacent processes by synchronize, which
+ * Observer::synchronize calls for every variable. In a wrapped world
+ * coordinates off the world's edges are wrapped, so buffer zone values can
+ * be read by either their wrapped or unwrapped coordinates.
+ *
+ * Patch variables are created with Observer::createPatchVariable and are
+ * available whether or not the world has patch agents.
+ *
+ * @tparam T the type of the variable's values
+ */
+template<typename T>
+class PatchVariable: public BasePatchVariable, public ValueLayerND<T> {
+
+private:
+	// wraps coordinates that have run off a periodic world, which
+	// ValueLayerND expects in the global bounds
+	static int wrap(DimensionDatum<T>& datum, int coord) {
+		if (datum.periodic && (coord < datum.globalCoordinateMin || coord >= datum.globalCoordinateMax)) {
+			coord = (coord - datum.globalCoordinateMin) % datum.globalWidth;
+			if (coord < 0) coord += datum.globalWidth;
+			coord += datum.globalCoordinateMin;
+		}
+		return coord;
+	}
+
+	// the index of the patch's value, throwing if it isn't held here
+	int index(int x, int y) {
+		DimensionDatum<T>& xDatum = this->dimensionData[0];
+		DimensionDatum<T>& yDatum = this->dimensionData[1];
+		int col = xDatum.getIndexedCoord(wrap(xDatum, x)), row = yDatum.getIndexedCoord(wrap(yDatum, y));
+		if (col < 0 || col >= xDatum.width || row < 0 || row >= yDatum.width)
+			throw ReLogo_Error_4(name(), x, y); // Patch is neither local nor in the buffer zone
+		return col * this->places[0] + row * this->places[1];
+	}
+
+public:
+
+	/**
+	 * The type of the variable's values.
+	 */
+	typedef T value_type;
+
+	/**
+	 * Creates a PatchVariable over the specified world.
+	 *
+	 * @param name the name of the variable
+	 * @param processDims the number of processes along the x and y dimensions
+	 * @param worldBounds the global bounds of the world's patches
+	 * @param buffer the size of the buffer zone
+	 * @param wrapped whether or not the world wraps
+	 * @param initialValue the value every patch starts with
+	 */
+	PatchVariable(const std::string& name, const std::vector<int>& processDims, const GridDimensions& worldBounds,
+			int buffer, bool wrapped, T initialValue) :
+			BasePatchVariable(name), ValueLayerND<T>(processDims, worldBounds, buffer, wrapped, initialValue,
+					initialValue) {
+	}
+
+	virtual ~PatchVariable() {
+	}
+
+	/**
+	 * Gets the value of the patch at the specified coordinates.
+	 *
+	 * @param x the patch x coordinate
+	 * @param y the patch y coordinate
+	 */
+	T get(int x, int y) {
+		return this->dataSpace[index(x, y)];
+	}
+
+	/**
+	 * Sets the value of the patch at the specified coordinates.
+	 *
+	 * @param x the patch x coordinate
+	 * @param y the patch y coordinate
+	 * @param value the new value
+	 */
+	void set(int x, int y, T value) {
+		this->dataSpace[index(x, y)] = value;
+	}
+
+	/**
+	 * Adds to the value of the patch at the specified coordinates.
+	 *
+	 * @param x the patch x coordinate
+	 * @param y the patch y coordinate
+	 * @param value the amount to add
+	 *
+	 * @return the new value
+	 */
+	T add(int x, int y, T value) {
+		return this->dataSpace[index(x, y)] += value;
+	}
+
+	// doc inherited from BasePatchVariable
+	virtual void synchronize() {
+		ValueLayerND<T>::synchronize();
+	}
+};
+
+}
+}
+
+#endif /* PATCHVARIABLE_H_ */
@@ -91,6 +91,29 @@ public:
       RESOLUTION    "Ensure that the network is created before any attempt to use it is made"
 END_ERR
 
+/* ERROR 4 */
+class ReLogo_Error_4: public std::out_of_range{
+public:
+  ReLogo_Error_4(std::string name, int x, int y): OUT_OF_RANGE(ERROR_NUMBER 4)
+      THROWN_BY     "PatchVariable::get, set or add"
+      REASON        "The patch at (" + VAL(x) + ", " + VAL(y) + ") is neither local nor in the buffer zone"
+      EXPLANATION   "Patch variable '" + name + "' only holds values for this process's patches and its buffer zone"
+      CAUSE         "Generally a coordinate further from the local bounds than the buffer size"
+      RESOLUTION    "Only access patches within the buffer size of the local bounds, or enlarge the buffer"
+END_ERR
+
+
+/* ERROR 5 */
+class ReLogo_Error_5: public std::invalid_argument{
+public:
+  ReLogo_Error_5(std::string name): INVALID_ARG(ERROR_NUMBER 5)
+      THROWN_BY     "Observer::createPatchVariable(const std::string& name, T initialValue)"
+      REASON        "A patch variable named '" + name + "' already exists"
+      EXPLANATION   "Patch variable names must be unique"
+      CAUSE         "Generally the variable was created twice"
+      RESOLUTION    "Create each patch variable once and keep the returned pointer, or look it up with patchVariable"
+END_ERR
+
 /* TEMPLATE
 class ReLogo_Error_: public std::invalid_argument{
 public:
@@ -44,24 +44,34 @@
 #include <boost/mpi/communicator.hpp>
 
 #include "repast_hpc/SharedDiscreteSpace.h"
+#include "PatchOccupancy.h"
 
 namespace repast {
 namespace relogo {
 
 /**
- * Repast SharedDiscreteSpace specialized for Relogo.
+ * Repast SharedDiscreteSpace specialized for Relogo. Its cells are held in
+ * a PatchOccupancy, so the patch at a location can be found directly.
  */
 template <typename GPTransformer, typename Adder>
-class RelogoSharedDiscreteSpace : public repast::SharedDiscreteSpace<RelogoAgent, GPTransformer, Adder> {
+class RelogoSharedDiscreteSpace : public repast::SharedDiscreteSpace<RelogoAgent, GPTransformer, Adder, PatchOccupancy<RelogoAgent, int> > {
 
 public:
 	virtual ~RelogoSharedDiscreteSpace() {}
 	RelogoSharedDiscreteSpace(std::string name, repast::GridDimensions gridDims, std::vector<int> processDims, int buffer, boost::mpi::communicator* comm);
+
+	/**
+	 * Gets the cell accessor, which holds the patches of the local bounds
+	 * plus the buffer.
+	 */
+	const PatchOccupancy<RelogoAgent, int>& patchOccupancy() const {
+		return this->cellAccessor;
+	}
 };
 
 template <typename GPTransformer, typename Adder>
 RelogoSharedDiscreteSpace<GPTransformer, Adder>::RelogoSharedDiscreteSpace(std::string name, repast::GridDimensions gridDims, std::vector<int> processDims, int buffer, boost::mpi::communicator* comm) :
-repast::SharedDiscreteSpace<RelogoAgent, GPTransformer, Adder>(name, gridDims, processDims, buffer, comm) {}
+repast::SharedDiscreteSpace<RelogoAgent, GPTransformer, Adder, PatchOccupancy<RelogoAgent, int> >(name, gridDims, processDims, buffer, comm) {}
 
 
 }
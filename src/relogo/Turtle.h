@@ -717,11 +717,17 @@ private:
 	typedef boost::unordered_set<Turtle*, AgentHashId<Turtle> > TiedSetType;
 	TiedSetType fixedLeaves, freeLeaves;
 
+	/*
+	 * Moves this turtle from oldLocation to the already transformed
+	 * location in the space and the grid, and then moves any tied turtles.
+	 */
+	void relocate(const Point<double, 2>& oldLocation, Point<double, 2>& location);
+
 	/*
 	 * Moves tied turtles vector diff between oldLocation and this
 	 * turtles current location
 	 */
-	void moveTiedTurtles(const Point<double>& oldLocation);
+	void moveTiedTurtles(const Point<double, 2>& oldLocation);
 	/*
 	 * Moves a tied turtle as the result of this turtle changing its heading.
 	 */
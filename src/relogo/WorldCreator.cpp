@@ -56,6 +56,14 @@ repast::Projection<RelogoAgent>*  WorldCreator::createDiscreteSpace(const WorldD
 
 }
 
+const PatchOccupancy<RelogoAgent, int>* WorldCreator::patchOccupancy(repast::Projection<RelogoAgent>* grid, const WorldDefinition& def) const {
+	if (def.isWrapped()) {
+		return &static_cast<ToroidalDiscreteSpace*> (grid)->patchOccupancy();
+	} else {
+		return &static_cast<BoundedDiscreteSpace*> (grid)->patchOccupancy();
+	}
+}
+
 repast::Projection<RelogoAgent>*  WorldCreator::createContinuousSpace(const WorldDefinition& def, const std::vector<int>& pConfiguration) const {
 	repast::Projection<RelogoAgent>* proj = 0;
   GridDimensions originalDimensions = def.dimensions();
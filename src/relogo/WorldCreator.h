@@ -104,6 +104,7 @@ private:
 
 	repast::Projection<RelogoAgent>*  createDiscreteSpace(const WorldDefinition&, const std::vector<int>&) const;
 	repast::Projection<RelogoAgent>*  createContinuousSpace(const WorldDefinition&, const std::vector<int>&) const;
+	const PatchOccupancy<RelogoAgent, int>* patchOccupancy(repast::Projection<RelogoAgent>* grid, const WorldDefinition&) const;
 };
 
 template<typename ObsType, typename PatchType>
@@ -132,11 +133,17 @@ ObsType* WorldCreator::createWorld(const WorldDefinition& worldDef, const std::v
 	RelogoGridType* grid = static_cast<RelogoGridType*> (observer->context.getProjection(GRID_NAME));
 	RelogoSpaceType* space = static_cast<RelogoSpaceType*> (observer->context.getProjection(SPACE_NAME));
 	observer->localBounds = grid->dimensions();
+	observer->patchCells = patchOccupancy(observer->context.getProjection(GRID_NAME), worldDef);
+
+	observer->worldBounds = worldDef.dimensions();
+	observer->processDims = pConfig;
+	observer->bufferSize = worldDef.buffer();
+	observer->wrapped = worldDef.isWrapped();
 
 	int id = 0;
 
 	GridDimensions dims = grid->dimensions();
-	for (int x = dims.origin(0), n = dims.origin(0) + dims.extents(0); x < n; ++x) {
+	for (int x = dims.origin(0), n = dims.origin(0) + dims.extents(0); x < n && worldDef.createPatches(); ++x) {
 		for (int y = dims.origin(1), k = dims.origin(1) + dims.extents(1); y < k; ++y) {
 			repast::AgentId agentId(id, observer->rank(), PATCH_TYPE_ID);
 			agentId.currentRank(observer->_rank);
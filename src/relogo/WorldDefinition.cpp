@@ -52,7 +52,7 @@ namespace relogo {
 
 WorldDefinition::WorldDefinition(int minX, int minY, int maxX, int maxY, bool wrapped, int buffer) :
 	_dims(GridDimensions(Point<double> ((double)minX, (double)minY), Point<double> ((double)(maxX - minX + 1) , (double)(maxY - minY + 1)))), _wrapped(wrapped),
-			_buffer(buffer)  {
+			_buffer(buffer), _createPatches(true)  {
 }
 
 WorldDefinition::~WorldDefinition() {
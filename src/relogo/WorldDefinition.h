@@ -65,6 +65,7 @@ private:
   GridDimensions                        _dims;
   bool                                  _wrapped;
   int                                   _buffer;
+  bool                                  _createPatches;
   std::vector<Projection<RelogoAgent>*> networks;
 
 
@@ -192,6 +193,28 @@ public:
 		return _buffer;
 	}
 
+	/**
+	 * Sets whether or not patch agents are created for the world. A world
+	 * whose patch state lives entirely in patch variables (see
+	 * Observer::createPatchVariable) can skip creating them. Without
+	 * patches, patchAt and the other patch queries find nothing. Patches
+	 * are created by default.
+	 *
+	 * @param createPatches whether or not to create patch agents
+	 */
+	void setCreatePatches(bool createPatches) {
+		_createPatches = createPatches;
+	}
+
+	/**
+	 * Gets whether or not patch agents are created for the world.
+	 *
+	 * @return true if patch agents are created, otherwise false.
+	 */
+	bool createPatches() const {
+		return _createPatches;
+	}
+
 
 };
 
@@ -54,19 +54,6 @@ AgentId::AgentId(int id, int startProc, int agentType, int currentProc) : id_(id
 	hash = 31 * hash + boost::hash_value(agentType_);
 }
 
-bool operator==(const AgentId &one, const AgentId &two) {
-	return one.id_ == two.id_ && one.startProc_ == two.startProc_ && one.agentType_ == two.agentType_;
-}
-
-bool operator!=(const AgentId &one, const AgentId &two) {
-	return !(one == two);
-}
-
-bool operator<(const AgentId &one, const AgentId &two) {
-	return ((one.agentType_ < two.agentType_) ||
-			((one.agentType_ == two.agentType_) && (one.startProc_ < two.startProc_)) ||
-			((one.agentType_ == two.agentType_) && (one.startProc_ == two.startProc_) && (one.id_ < two.id_)));
-}
 	
 	
 AgentId::~AgentId() {}
@@ -165,18 +165,27 @@ std::ostream& operator<<(std::ostream& os, const AgentId& id);
 /**
  * Equality operator
  */
-bool operator==(const AgentId &one, const AgentId &two);
+inline bool operator==(const AgentId &one, const AgentId &two) {
+	return one.id_ == two.id_ && one.startProc_ == two.startProc_ && one.agentType_ == two.agentType_;
+}
 
 /**
  * Inequality operator
  */
-bool operator!=(const AgentId &one, const AgentId &two);
+inline bool operator!=(const AgentId &one, const AgentId &two) {
+	return !(one == two);
+}
 
 	
 /**
- *  A comparison operator for use with std::set
+ *  A comparison operator for use with std::set. Inline, as the sync
+ *  bookkeeping sorts and searches large sets of ids.
  */
-bool operator<(const AgentId &one, const AgentId &two);
+inline bool operator<(const AgentId &one, const AgentId &two) {
+	return ((one.agentType_ < two.agentType_) ||
+			((one.agentType_ == two.agentType_) && (one.startProc_ < two.startProc_)) ||
+			((one.agentType_ == two.agentType_) && (one.startProc_ == two.startProc_) && (one.id_ < two.id_)));
+}
 
 /**
  * operator() implementation that returns the hashcode of
@@ -0,0 +1,213 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  AgentIdSet.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef AGENTIDSET_H_
+#define AGENTIDSET_H_
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+#include "AgentId.h"
+
+namespace repast {
+
+/**
+ * A set of AgentIds held in a single sorted vector, used for the
+ * bookkeeping done when agents and projection information are
+ * synchronized across processes. Unlike a std::set, inserting an id does
+ * not allocate a node: ids are appended and the vector is sorted (and
+ * duplicates removed) in bulk the next time the set is read. Clearing the
+ * set keeps its capacity, so a set that is reused each tick stops
+ * allocating once it has grown to its working size.
+ *
+ * Ids are ordered and compared as AgentIds are, ignoring the current
+ * rank. Iterators are invalidated by any insert or erase.
+ */
+class AgentIdSet {
+
+private:
+	mutable std::vector<AgentId> ids;
+	mutable size_t sortedCount; // ids before this index are sorted and unique
+
+	void normalize() const;
+
+public:
+
+	typedef std::vector<AgentId>::const_iterator const_iterator;
+	typedef const_iterator iterator;
+
+	AgentIdSet() :
+			sortedCount(0) {
+	}
+
+	/**
+	 * Reserves space for the specified number of ids.
+	 */
+	void reserve(size_t count) {
+		ids.reserve(count);
+	}
+
+	/**
+	 * Inserts the specified id.
+	 */
+	void insert(const AgentId& id) {
+		ids.push_back(id);
+	}
+
+	/**
+	 * Inserts the ids in the specified range.
+	 */
+	template<typename InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		ids.insert(ids.end(), first, last);
+	}
+
+	/**
+	 * Removes the specified id.
+	 */
+	void erase(const AgentId& id);
+
+	/**
+	 * Removes all the ids in the specified set, in a single pass.
+	 */
+	void erase(const AgentIdSet& other);
+
+	/**
+	 * Gets whether or not the set contains the specified id.
+	 */
+	bool contains(const AgentId& id) const {
+		normalize();
+		return std::binary_search(ids.begin(), ids.end(), id);
+	}
+
+	/**
+	 * Gets the number of times the specified id is in the set, 0 or 1.
+	 */
+	size_t count(const AgentId& id) const {
+		return contains(id) ? 1 : 0;
+	}
+
+	/**
+	 * Finds the specified id, returning end() if the set doesn't contain it.
+	 */
+	const_iterator find(const AgentId& id) const;
+
+	/**
+	 * Gets the number of ids in the set.
+	 */
+	size_t size() const {
+		normalize();
+		return ids.size();
+	}
+
+	bool empty() const {
+		return ids.empty();
+	}
+
+	/**
+	 * Removes all the ids, keeping the capacity.
+	 */
+	void clear() {
+		ids.clear();
+		sortedCount = 0;
+	}
+
+	/**
+	 * Gets an iterator to the first id, in AgentId order.
+	 */
+	const_iterator begin() const {
+		normalize();
+		return ids.begin();
+	}
+
+	const_iterator end() const {
+		normalize();
+		return ids.end();
+	}
+
+};
+
+inline void AgentIdSet::normalize() const {
+	if (sortedCount == ids.size()) return;
+
+	std::vector<AgentId>::iterator mid = ids.begin() + sortedCount;
+	if (!std::is_sorted(mid, ids.end())) std::sort(mid, ids.end());
+	if (sortedCount > 0 && !(*(mid - 1) < *mid)) std::inplace_merge(ids.begin(), mid, ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+	sortedCount = ids.size();
+}
+
+inline void AgentIdSet::erase(const AgentId& id) {
+	normalize();
+	std::vector<AgentId>::iterator iter = std::lower_bound(ids.begin(), ids.end(), id);
+	if (iter != ids.end() && *iter == id) {
+		ids.erase(iter);
+		sortedCount--;
+	}
+}
+
+inline void AgentIdSet::erase(const AgentIdSet& other) {
+	if (other.empty() || empty()) return;
+	normalize();
+	other.normalize();
+
+	// an in place set difference; the write position never passes the read position
+	std::vector<AgentId>::iterator out = ids.begin();
+	std::vector<AgentId>::const_iterator remove = other.ids.begin(), removeEnd = other.ids.end();
+	for (std::vector<AgentId>::iterator iter = ids.begin(), iterEnd = ids.end(); iter != iterEnd; ++iter) {
+		while (remove != removeEnd && *remove < *iter)
+			++remove;
+		if (remove != removeEnd && *remove == *iter) continue;
+		if (out != iter) *out = *iter;
+		++out;
+	}
+	ids.erase(out, ids.end());
+	sortedCount = ids.size();
+}
+
+inline AgentIdSet::const_iterator AgentIdSet::find(const AgentId& id) const {
+	normalize();
+	const_iterator iter = std::lower_bound(ids.begin(), ids.end(), id);
+	return (iter != ids.end() && *iter == id) ? iter : ids.end();
+}
+
+}
+
+#endif /* AGENTIDSET_H_ */
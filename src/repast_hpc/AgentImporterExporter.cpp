@@ -258,7 +258,7 @@ std::string Importer_COUNT::getReport(){
   return ss.str();
 }
 
-void Importer_COUNT::getSetOfAgentsBeingImported(std::set<AgentId>& set){
+void Importer_COUNT::getSetOfAgentsBeingImported(AgentIdSet& set){
   // Not implemented for 'count'
 }
 
@@ -427,7 +427,7 @@ std::string Importer_LIST::getReport(){
   return ss.str();
 }
 
-void Importer_LIST::getSetOfAgentsBeingImported(std::set<AgentId>& set){
+void Importer_LIST::getSetOfAgentsBeingImported(AgentIdSet& set){
   if(sources.size() > 0){
     std::map<int, std::list<AgentId>* >::iterator it          = sources.begin();
     const std::map<int, std::list<AgentId>* >::iterator itEnd = sources.end();
@@ -547,7 +547,7 @@ std::string Importer_SET::getReport(){
   return ss.str();
 }
 
-void Importer_SET::getSetOfAgentsBeingImported(std::set<AgentId>& set){
+void Importer_SET::getSetOfAgentsBeingImported(AgentIdSet& set){
   if(sources.size() > 0){
     std::map<int, std::set<AgentId>* >::iterator it          = sources.begin();
     const std::map<int, std::set<AgentId>* >::iterator itEnd = sources.end();
@@ -728,7 +728,7 @@ std::string Importer_MAP_int::getReport(){
   return ss.str();
 }
 
-void Importer_MAP_int::getSetOfAgentsBeingImported(std::set<AgentId>& set){
+void Importer_MAP_int::getSetOfAgentsBeingImported(AgentIdSet& set){
   if(sources.size() > 0){
     std::map<int, std::map<AgentId, int>* >::iterator it          = sources.begin();
     const std::map<int, std::map<AgentId, int>* >::iterator itEnd = sources.end();
@@ -1391,7 +1391,7 @@ const std::map<int, AgentRequest>& ImporterExporter_BY_SET::getAgentsToExport(st
 }
 
 
-void ImporterExporter_BY_SET::getSetOfAgentsBeingImported(std::set<AgentId>& set){
+void ImporterExporter_BY_SET::getSetOfAgentsBeingImported(AgentIdSet& set){
   std::map<std::string, AbstractImporterExporter*>::iterator mapIter = importersExportersMap.begin();
   while(mapIter != importersExportersMap.end()){
     mapIter->second->getSetOfAgentsBeingImported(set);
@@ -1399,7 +1399,7 @@ void ImporterExporter_BY_SET::getSetOfAgentsBeingImported(std::set<AgentId>& set
   }
 }
 
-void ImporterExporter_BY_SET::getSetOfAgentsBeingImported(std::set<AgentId>& set, std::string excludeSet){
+void ImporterExporter_BY_SET::getSetOfAgentsBeingImported(AgentIdSet& set, std::string excludeSet){
   std::map<std::string, AbstractImporterExporter*>::iterator mapIter = importersExportersMap.begin();
   while(mapIter != importersExportersMap.end()){
     if(mapIter->first.compare(excludeSet) != 0)    mapIter->second->getSetOfAgentsBeingImported(set);
@@ -44,6 +44,7 @@
 
 #include "AgentRequest.h"
 #include "AgentId.h"
+#include "AgentIdSet.h"
 #include "AgentStatus.h"
 #include "mpi_constants.h"
 
@@ -342,7 +343,7 @@ public:
    */
   virtual std::string getReport() = 0;
 
-  virtual void getSetOfAgentsBeingImported(std::set<AgentId>& set) = 0;
+  virtual void getSetOfAgentsBeingImported(AgentIdSet& set) = 0;
 
   virtual void clear(){
     exportingProcesses.clear();
@@ -377,7 +378,7 @@ public:
   virtual void importedAgentIsMoved(const AgentId& id, int newProcess);
 
   virtual std::string getReport();
-  virtual void getSetOfAgentsBeingImported(std::set<AgentId>& set);
+  virtual void getSetOfAgentsBeingImported(AgentIdSet& set);
 };
 #endif
 
@@ -433,7 +434,7 @@ public:
   virtual void importedAgentIsMoved(const AgentId& id, int newProcess);
 
   virtual std::string getReport();
-  virtual void getSetOfAgentsBeingImported(std::set<AgentId>& set);
+  virtual void getSetOfAgentsBeingImported(AgentIdSet& set);
 
   virtual void clear(){
     AbstractImporter::clear();
@@ -491,7 +492,7 @@ public:
   virtual void importedAgentIsMoved(const AgentId& id, int newProcess);
 
   virtual std::string getReport();
-  virtual void getSetOfAgentsBeingImported(std::set<AgentId>& set);
+  virtual void getSetOfAgentsBeingImported(AgentIdSet& set);
   virtual void clear(){
     AbstractImporter::clear();
 
@@ -559,7 +560,7 @@ public:
   virtual void importedAgentIsMoved(const AgentId& id, int newProcess);
 
   virtual std::string getReport();
-  virtual void getSetOfAgentsBeingImported(std::set<AgentId>& set);
+  virtual void getSetOfAgentsBeingImported(AgentIdSet& set);
 
   virtual void clear(){
     AbstractImporter::clear();
@@ -805,7 +806,7 @@ public:
 
   virtual       void           importedAgentIsNowLocal(const AgentId& id){                                importer->importedAgentIsNowLocal(id);           }
 
-  virtual       void           getSetOfAgentsBeingImported(std::set<AgentId>& set){                       importer->getSetOfAgentsBeingImported(set);      }
+  virtual       void           getSetOfAgentsBeingImported(AgentIdSet& set){                       importer->getSetOfAgentsBeingImported(set);      }
 
   virtual const AbstractExporter::StatusMap* getOutgoingStatusChanges();
 
@@ -1061,8 +1062,8 @@ public:
     return ss.str();
   }
 
-  virtual void getSetOfAgentsBeingImported(std::set<AgentId>& set);
-  void getSetOfAgentsBeingImported(std::set<AgentId>& set, std::string excludeSet);
+  virtual void getSetOfAgentsBeingImported(AgentIdSet& set);
+  void getSetOfAgentsBeingImported(AgentIdSet& set, std::string excludeSet);
 
   virtual void clear(){
     std::map<std::string, AbstractImporterExporter*>::iterator it    = importersExportersMap.begin();
@@ -57,18 +57,32 @@
 
 namespace repast {
 
+/**
+ * Location held for an agent that has not yet been placed in a grid.
+ */
+template<typename GPType>
+Point<GPType> unplacedLocation(const Point<GPType>*) {
+	return Point<GPType> (0);
+}
+
+template<typename GPType, std::size_t N>
+Point<GPType, N> unplacedLocation(const Point<GPType, N>*) {
+	return Point<GPType, N> ();
+}
+
 /**
  * Encapsulates a grid point and what is held in it.
  */
-template<typename T, typename GPType>
+template<typename T, typename GPType, typename PointType = Point<GPType> >
 struct GridPointHolder {
 
 	bool inGrid;
-	Point<GPType> point;
+	int zone; // classification of point kept by the grid, see BaseGrid::agentMoved
+	PointType point;
 	boost::shared_ptr<T> ptr;
 
 	GridPointHolder() :
-		inGrid(false), point(0) {
+		inGrid(false), zone(0), point(unplacedLocation(static_cast<const PointType*> (0))) {
 	}
 };
 
@@ -76,12 +90,12 @@ struct GridPointHolder {
  *  Unary function used in the transform_iterator that allows context iterators
  *  to return the agent maps values.
  */
-template<typename T, typename GPType>
+template<typename T, typename GPType, typename PointType = Point<GPType> >
 struct AgentFromGridPoint: public std::unary_function<typename boost::unordered_map<AgentId,
-		GridPointHolder<T, GPType>*>::value_type, boost::shared_ptr<T> > {
+		GridPointHolder<T, GPType, PointType>*>::value_type, boost::shared_ptr<T> > {
 	boost::shared_ptr<T> operator()(
-			const typename boost::unordered_map<AgentId, GridPointHolder<T, GPType>*>::value_type& value) const {
-		GridPointHolder<T, GPType> *gp = value.second;
+			const typename boost::unordered_map<AgentId, GridPointHolder<T, GPType, PointType>*>::value_type& value) const {
+		GridPointHolder<T, GPType, PointType> *gp = value.second;
 		return gp->ptr;
 	}
 
@@ -93,7 +107,10 @@ struct AgentFromGridPoint: public std::unary_function<typename boost::unordered_
  * can be found in Space in Space.h
  *
  * @tparam T the type of objects contained by this BaseGrid (generally the type of agents)
- * @tparam CellAccessor implements the actual storage for the grid.
+ * @tparam CellAccessor implements the actual storage for the grid. Its PointType
+ * typedef is the point type agent locations are held as; a fixed dimension
+ * Point<GPType, N> lets moves and lookups made with Point<GPType, N> run
+ * without allocating.
  * @tparam GPTransformer transforms cell points according to the topology (e.g. periodic)
  * of the BaseGrid.
  * @tparam Adder determines how objects are added to the grid from its associated context.
@@ -103,19 +120,26 @@ struct AgentFromGridPoint: public std::unary_function<typename boost::unordered_
 template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
 class BaseGrid: public Grid<T, GPType> {
 
+public:
+
+	/**
+	 * The type of point agent locations are held as.
+	 */
+	typedef typename CellAccessor::PointType PointType;
+
 private:
 
 	// we use a GridPointHolder so we can swap out the GridPoint for an
 	// agent with a single map access, rather than have to put the new
 	// GridPoint back in the map.
-	typedef typename boost::unordered_map<AgentId, GridPointHolder<T, GPType>*, HashId> AgentLocationMap;
+	typedef GridPointHolder<T, GPType, PointType> PointHolder;
+	typedef typename boost::unordered_map<AgentId, PointHolder*, HashId> AgentLocationMap;
 
 	AgentLocationMap agentToLocation;
 	GridDimensions dimensions_;
 
-	CellAccessor cellAccessor;
-
-	bool doMove(std::vector<GPType>& point, GridPointHolder<T, GPType>* gpHolder);
+	template<typename LocationType>
+	bool doMove(const LocationType& location, PointHolder* gpHolder);
 
 	size_t size_;
 
@@ -124,6 +148,7 @@ protected:
 	typedef typename AgentLocationMap::iterator LocationMapIter;
 	typedef typename AgentLocationMap::const_iterator LocationMapConstIter;
 
+	CellAccessor cellAccessor;
 	GPTransformer gpTransformer;
 	Adder adder;
 
@@ -139,12 +164,35 @@ protected:
 
 	T* get(const AgentId& id);
 
+	/**
+	 * Called after an agent has been placed at a new location, with the zone
+	 * kept for the agent since its previous move (0 if it was not yet in the
+	 * grid). Subclasses can override this to classify agent locations as they
+	 * move; the zone returned is kept with the agent. The default keeps the zone.
+	 *
+	 * @param id the id of the moved agent
+	 * @param zone the zone kept for the agent
+	 * @param location the agent's new location
+	 *
+	 * @return the zone to keep for the agent
+	 */
+	virtual int agentMoved(const AgentId& id, int zone, const PointType& location) {
+		return zone;
+	}
+
+	/**
+	 * Called when an agent that has been placed in the grid is removed, with
+	 * the zone kept for it.
+	 */
+	virtual void agentRemoved(const AgentId& id, int zone) {
+	}
+
 public:
 
 	/**
 	 * A const iterator over shared_ptr<T>.
 	 */
-	typedef typename boost::transform_iterator<AgentFromGridPoint<T, GPType> , LocationMapConstIter> const_iterator;
+	typedef typename boost::transform_iterator<AgentFromGridPoint<T, GPType, PointType> , LocationMapConstIter> const_iterator;
 
 	/**
 	 * Creates a BaseGrid with the specified name and dimensions.
@@ -164,12 +212,51 @@ public:
 	// doc inherited from Grid
 	virtual bool getLocation(const AgentId& id, std::vector<GPType>& out) const;
 
+	/**
+	 * Gets the location of the specified agent as a point.
+	 *
+	 * @param id the id of the agent
+	 * @param [out] out the agent's location
+	 *
+	 * @return true if the agent is in the grid, otherwise false
+	 */
+	template<std::size_t N>
+	bool getLocation(const AgentId& id, Point<GPType, N>& out) const;
+
 	// doc inherited from Grid
 	virtual T* getObjectAt(const Point<GPType>& pt) const;
 
+	// doc inherited from Grid
+	virtual T* getObjectAt(const Point<GPType, 2>& pt) const {
+		return getObjectAt<2> (pt);
+	}
+
+	/**
+	 * Gets the first object found at the specified fixed dimension point, or
+	 * NULL if there is no such object. The lookup does not allocate.
+	 */
+	template<std::size_t N>
+	T* getObjectAt(const Point<GPType, N>& pt) const {
+		return cellAccessor.get(pt);
+	}
+
 	// doc inherited from Grid
 	virtual void getObjectsAt(const Point<GPType>& pt, std::vector<T*>& out) const;
 
+	// doc inherited from Grid
+	virtual void getObjectsAt(const Point<GPType, 2>& pt, std::vector<T*>& out) const {
+		getObjectsAt<2> (pt, out);
+	}
+
+	/**
+	 * Gets all the objects found at the specified fixed dimension point. The
+	 * lookup does not allocate.
+	 */
+	template<std::size_t N>
+	void getObjectsAt(const Point<GPType, N>& pt, std::vector<T*>& out) const {
+		cellAccessor.getAll(pt, out);
+	}
+
 	/**
 	 * Moves the specified agent to the specified location. Returns
 	 * true if the move was successful otherwise false. The agent
@@ -212,6 +299,37 @@ public:
 	// doc inherited from Grid
 	virtual bool moveTo(const AgentId& id, const Point<GPType>& pt);
 
+	// doc inherited from Grid
+	virtual bool moveTo(const AgentId& id, const Point<GPType, 2>& pt) {
+		return moveTo<2> (id, pt);
+	}
+
+	/**
+	 * Moves the specified agent to the specified fixed dimension location.
+	 * The location is transformed in place, and when the CellAccessor is keyed
+	 * on the same point type the move itself does not allocate any points.
+	 *
+	 * @param id the id of the agent to move
+	 * @param newLocation the location to move to
+	 *
+	 * @return true if the move was successful, otherwise false
+	 */
+	template<std::size_t N>
+	bool moveTo(const AgentId& id, const Point<GPType, N>& newLocation);
+
+	/**
+	 * Moves the specified agent to the specified fixed dimension location.
+	 *
+	 * @param agent the agent to move
+	 * @param newLocation the location to move to
+	 *
+	 * @return true if the move was successful, otherwise false
+	 */
+	template<std::size_t N>
+	bool moveTo(const T* agent, const Point<GPType, N>& newLocation) {
+		return moveTo(agent->getId(), newLocation);
+	}
+
 	// doc inherited from Grid
 	virtual std::pair<bool, Point<GPType> > moveByDisplacement(const T* agent, const std::vector<GPType>& displacement);
 
@@ -263,16 +381,33 @@ public:
 		return dimensions_;
 	}
 
+	// doc inherited from Grid; a grid that is not shared across processes
+	// is bounded by its own dimensions
+	virtual const GridDimensions bounds() const {
+		return dimensions_;
+	}
+
 	// doc inherited from Grid
 	virtual void translate(const Point<GPType>& location, const Point<GPType>& displacement, std::vector<GPType>& out) const {
 		gpTransformer.translate(location.coords(), out, displacement.coords());
 	}
 
+	// doc inherited from Grid
+	virtual void translate(const Point<GPType, 2>& location, const Point<GPType, 2>& displacement,
+			Point<GPType, 2>& out) const {
+		gpTransformer.translate(location, out, displacement);
+	}
+
 	// doc inherited from Grid
 	virtual void transform(const std::vector<GPType>& location, std::vector<GPType>& out) const {
 		gpTransformer.transform(location, out);
 	}
 
+	// doc inherited from Grid
+	virtual void transform(const Point<GPType, 2>& location, Point<GPType, 2>& out) const {
+		gpTransformer.transform(location, out);
+	}
+
 	// doc inherited from Grid
 	virtual bool isPeriodic() const {
 		return gpTransformer.isPeriodic();
@@ -282,7 +417,18 @@ public:
 
   virtual void updateProjectionInfo(ProjectionInfoPacket* pip, Context<T>* context);
 
-  virtual void getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush){ }
+  // Grid projection info is the agent's location, which packs as flat bytes
+  virtual bool projectionInfoIsPackable(){ return true; }
+
+  virtual void packProjectionInfo(ProjectionInfoPacket* pip, std::vector<char>& buffer){
+    packProjectionInfoPacket(*static_cast<SpecializedProjectionInfoPacket<GPType>*>(pip), buffer);
+  }
+
+  virtual ProjectionInfoPacket* unpackProjectionInfo(const char*& position){
+    return unpackProjectionInfoPacket<GPType>(position);
+  }
+
+  virtual void getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush){ }
   virtual void getInfoExchangePartners(std::set<int>& psToSendTo, std::set<int>& psToReceiveFrom) {}
   virtual void getAgentStatusExchangePartners(std::set<int>& psToSendTo, std::set<int>& psToReceiveFrom) {}
 };
@@ -316,17 +462,28 @@ bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::getLocation(const
 	if (iter == agentToLocation.end())
 		return false;
 
-	GridPointHolder<T, GPType>* holder = iter->second;
+	PointHolder* holder = iter->second;
 	if (!holder->inGrid)
 		return false;
 
 	if (out.size() != dimensions_.dimensionCount())
 		out.resize(dimensions_.dimensionCount(), 0);
-	holder->point.copy(out);
+	std::copy(holder->point.begin(), holder->point.end(), out.begin());
 	return true;
 
 }
 
+template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
+template<std::size_t N>
+bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::getLocation(const AgentId& id, Point<GPType, N>& out) const {
+	LocationMapConstIter iter = agentToLocation.find(id);
+	if (iter == agentToLocation.end() || !iter->second->inGrid)
+		return false;
+
+	out = Point<GPType, N> (iter->second->point);
+	return true;
+}
+
 template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
 bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::getLocation(const T* agent, std::vector<GPType>& out) const {
 	return getLocation(agent->getId(), out);
@@ -368,22 +525,41 @@ bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::moveTo(const Agent
 	std::vector<GPType> transformedCoords(newLocation.size(), 0);
 	gpTransformer.transform(newLocation, transformedCoords);
 
-	if (iter->second->point.coords() == transformedCoords)  return true;
-	return doMove(transformedCoords, iter->second);
+	if (iter->second->inGrid && EqualGridPoint()(iter->second->point, transformedCoords))  return true;
+	return doMove(PointType(transformedCoords), iter->second);
+}
+
+template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
+template<std::size_t N>
+bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::moveTo(const AgentId& id,
+		const Point<GPType, N>& newLocation) {
+  LocationMapIter iter = agentToLocation.find(id);
+
+  if (iter == agentToLocation.end())
+		throw Repast_Error_2<AgentId>(id, Projection<T>::name()); // Agent has not yet been introduced to this space/is not present
+
+	if (N < dimensions_.dimensionCount())
+		throw Repast_Error_3(N, dimensions_.dimensionCount()); // Destination not fully specified
+
+	Point<GPType, N> transformed;
+	gpTransformer.transform(newLocation, transformed);
+
+	if (iter->second->inGrid && EqualGridPoint()(iter->second->point, transformed))  return true;
+	return doMove(transformed, iter->second);
 }
 
 template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
-bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::doMove(std::vector<GPType>& location, GridPointHolder<T,
-		GPType>* gpHolder) {
-	Point<GPType> pt(location);
-	if (cellAccessor.put(gpHolder->ptr, pt)) {
+template<typename LocationType>
+bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::doMove(const LocationType& location, PointHolder* gpHolder) {
+	if (cellAccessor.put(gpHolder->ptr, location)) {
 		if (gpHolder->inGrid) {
 			cellAccessor.remove(gpHolder->ptr, gpHolder->point);
 		} else {
 			size_++;
 			gpHolder->inGrid = true;
 		}
-		gpHolder->point = pt;
+		gpHolder->point = location;
+		gpHolder->zone = agentMoved(gpHolder->ptr->getId(), gpHolder->zone, gpHolder->point);
 		return true;
 	}
 	return false;
@@ -409,12 +585,13 @@ std::pair<bool, Point<GPType> > BaseGrid<T, CellAccessor, GPTransformer, Adder,
 	if (iter == agentToLocation.end())
       throw Repast_Error_6<AgentId>(agent->getId(), Projection<T>::name()); // Agent has not in this grid / space
 
-	GridPointHolder<T, GPType>* gpHolder = iter->second;
+	PointHolder* gpHolder = iter->second;
+	std::vector<GPType> oldPos(gpHolder->point.begin(), gpHolder->point.end());
 	std::vector<GPType> newPos(displacement.size(), 0);
-	gpTransformer.translate(gpHolder->point.coords(), newPos, displacement);
+	gpTransformer.translate(oldPos, newPos, displacement);
 	std::vector<GPType> transformedCoords(newPos.size(), 0);
 	gpTransformer.transform(newPos, transformedCoords);
-	if (iter->second->point.coords() == transformedCoords)
+	if (EqualGridPoint()(gpHolder->point, transformedCoords))
 		return std::make_pair(true, Point<GPType> (transformedCoords));
 	return std::make_pair(moveTo(agent->getId(), transformedCoords), Point<GPType> (transformedCoords));
 }
@@ -433,7 +610,7 @@ void BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::getObjectsAt(const
 template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
 bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::addAgent(boost::shared_ptr<T> agent) {
   if(!Projection<T>::agentCanBeAdded(agent)) return false;
-  GridPointHolder<T, GPType>* gp = new GridPointHolder<T, GPType> ();
+  PointHolder* gp = new PointHolder();
   gp->ptr = agent;
   agentToLocation[agent->getId()] = gp;
   return adder.add(agent);
@@ -443,8 +620,10 @@ template<typename T, typename CellAccessor, typename GPTransformer, typename Add
 void BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::removeAgent(T* agent) {
 	LocationMapIter iter = agentToLocation.find(agent->getId());
 	if (iter != agentToLocation.end()) {
-		GridPointHolder<T, GPType>* gp = iter->second;
+		PointHolder* gp = iter->second;
 		cellAccessor.remove(gp->ptr, gp->point);
+		if (gp->inGrid)
+			agentRemoved(iter->first, gp->zone);
 		delete gp;
 		agentToLocation.erase(iter);
 	}
@@ -501,7 +680,8 @@ ProjectionInfoPacket* BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::g
       return 0;
   }
   else{
-      return new SpecializedProjectionInfoPacket<GPType>(id, agentIter->second->point.coords());
+      const PointType& location = agentIter->second->point;
+      return new SpecializedProjectionInfoPacket<GPType>(id, std::vector<GPType>(location.begin(), location.end()));
   }
 }
 
@@ -0,0 +1,432 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  BinnedMultipleOccupancy.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef BINNEDMULTIPLEOCCUPANCY_H_
+#define BINNEDMULTIPLEOCCUPANCY_H_
+
+#include <vector>
+#include <cmath>
+
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Point.h"
+#include "GridDimensions.h"
+
+namespace repast {
+
+/**
+ * Multiple occupancy cell accessor that also indexes its occupants in
+ * uniform bins, so that everything within a box can be found by visiting
+ * only the bins the box overlaps. This is what backs the neighborhood
+ * queries of SharedContinuousSpace.
+ *
+ * The bins within the bounds passed to init are held in a flat array; bins
+ * outside them (e.g. for buffer zone agents across a periodic border, or
+ * requested agents) are held in a hash map, so every location is binned.
+ * The index is kept up to date as agents are put and removed, so there is
+ * nothing to rebuild between moves. Bins hold raw pointers; the grid's own
+ * shared_ptr keeps each agent alive while it is placed.
+ *
+ * Exact location lookups scan the location's bin, so bins should be sized to
+ * hold a handful of agents. The bin width defaults to 1 and is widened when
+ * the bounds would otherwise need more than MAX_BINS bins.
+ *
+ * @param T the type of object in the Grid
+ * @param GPType the coordinate type of the grid point locations. This must
+ * be an int or a double.
+ * @param N the dimension count of the Point<GPType, N> locations are held
+ * as, or 0 for the dynamically sized Point<GPType>.
+ */
+template<typename T, typename GPType, std::size_t N = 0>
+class BinnedMultipleOccupancy {
+
+public:
+
+	/**
+	 * The type of point locations are held as.
+	 */
+	typedef Point<GPType, N> PointType;
+
+	/**
+	 * The largest number of bins init will put in the bin array.
+	 */
+	static const size_t MAX_BINS = 1 << 20;
+
+private:
+	struct Entry {
+		T* agent;
+		PointType location;
+
+		Entry(T* agent, const PointType& location) :
+				agent(agent), location(location) {
+		}
+	};
+
+	typedef std::vector<Entry> Entries;
+	typedef boost::unordered_map<std::vector<int>, Entries, boost::hash<std::vector<int> > > OverflowMap;
+
+	double width;
+	std::vector<double> origin, extents;
+	std::vector<int> binCounts;
+	std::vector<size_t> strides;
+	std::vector<Entries> bins;
+	OverflowMap overflow;
+	size_t size_;
+
+	int binCoordinate(double coordinate, size_t dimension) const {
+		return (int) std::floor((coordinate - origin[dimension]) / width);
+	}
+
+	template<std::size_t M>
+	std::vector<int> overflowKey(const Point<GPType, M>& location) const {
+		std::vector<int> key(location.dimensionCount());
+		for (size_t i = 0; i < key.size(); i++)
+			key[i] = (int) std::floor((location[i] - (i < origin.size() ? origin[i] : 0)) / width);
+		return key;
+	}
+
+	template<std::size_t M>
+	Entries* bin(const Point<GPType, M>& location, bool create);
+
+	template<std::size_t M>
+	const Entries* bin(const Point<GPType, M>& location) const {
+		return const_cast<BinnedMultipleOccupancy*> (this)->bin(location, false);
+	}
+
+	bool inArray(const Entries* entries) const {
+		return !bins.empty() && entries >= &bins.front() && entries <= &bins.back();
+	}
+
+	template<typename Visitor>
+	static void visitEntries(const Entries& entries, const std::vector<double>& lower,
+			const std::vector<double>& upper, Visitor& visit);
+
+	void rebin(double binWidth);
+
+public:
+
+	BinnedMultipleOccupancy() :
+			width(1), size_(0) {
+	}
+
+	/**
+	 * Sizes the bin array to cover the specified bounds. Any occupants are
+	 * rebinned.
+	 *
+	 * @param bounds the bounds to hold in the bin array
+	 */
+	void init(const GridDimensions& bounds);
+
+	/**
+	 * Sets the bin width, rebinning any occupants. A width close to the
+	 * typical query radius suits queryRadius and kNearest best.
+	 *
+	 * @param binWidth the new bin width
+	 */
+	void setBinWidth(double binWidth);
+
+	/**
+	 * Gets the bin width.
+	 */
+	double binWidth() const {
+		return width;
+	}
+
+	/**
+	 * Gets the number of bins in the bin array.
+	 */
+	size_t binCount() const {
+		return bins.size();
+	}
+
+	/**
+	 * Gets the first object found at the specified location.
+	 *
+	 * @param location the location to get the object at
+	 * @return the first object found at the specified location or 0 if there
+	 * are no objects at the specified location.
+	 */
+	template<std::size_t M>
+	T* get(const Point<GPType, M>& location) const;
+
+	/**
+	 * Gets all the items found at the specified location.
+	 *
+	 * @param location the location to get the items at
+	 * @param [out] the found items will be appended to this vector
+	 */
+	template<std::size_t M>
+	void getAll(const Point<GPType, M>& location, std::vector<T*>& out) const;
+
+	/**
+	 * Puts the specified item at the specified location.
+	 *
+	 * @param agent the item to put
+	 * @param location the location to put the item at
+	 */
+	template<std::size_t M>
+	bool put(boost::shared_ptr<T>& agent, const Point<GPType, M>& location);
+
+	/**
+	 * Removes the specified item from the specified location.
+	 *
+	 * @param agent the item to remove
+	 * @param location the location to remove the item from
+	 */
+	template<std::size_t M>
+	void remove(boost::shared_ptr<T>& agent, const Point<GPType, M>& location);
+
+	/**
+	 * Calls visit(agent, location) for every occupant whose location is
+	 * within the specified box, bounds included.
+	 *
+	 * @param lower the lower corner of the box
+	 * @param upper the upper corner of the box
+	 * @param visit the functor to call
+	 */
+	template<typename Visitor>
+	void visitBox(const std::vector<double>& lower, const std::vector<double>& upper, Visitor& visit) const;
+
+};
+
+template<typename T, typename GPType, std::size_t N>
+void BinnedMultipleOccupancy<T, GPType, N>::init(const GridDimensions& bounds) {
+	origin = bounds.origin().coords();
+	extents = bounds.extents().coords();
+	rebin(width);
+}
+
+template<typename T, typename GPType, std::size_t N>
+void BinnedMultipleOccupancy<T, GPType, N>::setBinWidth(double binWidth) {
+	if (binWidth > 0)
+		rebin(binWidth);
+}
+
+template<typename T, typename GPType, std::size_t N>
+void BinnedMultipleOccupancy<T, GPType, N>::rebin(double binWidth) {
+	Entries entries;
+	entries.reserve(size_);
+	for (size_t i = 0; i < bins.size(); i++)
+		entries.insert(entries.end(), bins[i].begin(), bins[i].end());
+	for (typename OverflowMap::const_iterator iter = overflow.begin(); iter != overflow.end(); ++iter)
+		entries.insert(entries.end(), iter->second.begin(), iter->second.end());
+
+	size_t dims = origin.size();
+	double count = 1;
+	for (size_t i = 0; i < dims; i++)
+		count *= std::max(1.0, std::ceil(extents[i] / binWidth));
+	if (count > MAX_BINS)
+		binWidth *= std::pow(count / MAX_BINS, 1.0 / dims) * 1.01;
+
+	width = binWidth;
+	binCounts.assign(dims, 0);
+	strides.assign(dims, 0);
+	size_t binTotal = dims == 0 ? 0 : 1;
+	for (size_t i = 0; i < dims; i++) {
+		binCounts[i] = (int) std::max(1.0, std::ceil(extents[i] / width));
+		strides[i] = binTotal;
+		binTotal *= binCounts[i];
+	}
+	std::vector<Entries>(binTotal).swap(bins);
+	overflow.clear();
+
+	for (size_t i = 0; i < entries.size(); i++)
+		bin(entries[i].location, true)->push_back(entries[i]);
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+typename BinnedMultipleOccupancy<T, GPType, N>::Entries* BinnedMultipleOccupancy<T, GPType, N>::bin(
+		const Point<GPType, M>& location, bool create) {
+	size_t dims = location.dimensionCount();
+	if (!bins.empty() && dims == origin.size()) {
+		size_t index = 0;
+		size_t i = 0;
+		for (; i < dims; i++) {
+			int b = binCoordinate(location[i], i);
+			if (b < 0 || b >= binCounts[i])
+				break;
+			index += b * strides[i];
+		}
+		if (i == dims)
+			return &bins[index];
+	}
+
+	std::vector<int> key = overflowKey(location);
+	if (create)
+		return &overflow[key];
+	typename OverflowMap::iterator iter = overflow.find(key);
+	return iter == overflow.end() ? NULL : &iter->second;
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+T* BinnedMultipleOccupancy<T, GPType, N>::get(const Point<GPType, M>& location) const {
+	const Entries* entries = bin(location);
+	if (entries != NULL) {
+		for (typename Entries::const_iterator iter = entries->begin(); iter != entries->end(); ++iter) {
+			if (EqualGridPoint()(iter->location, location))
+				return iter->agent;
+		}
+	}
+	return NULL;
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+void BinnedMultipleOccupancy<T, GPType, N>::getAll(const Point<GPType, M>& location, std::vector<T*>& out) const {
+	const Entries* entries = bin(location);
+	if (entries != NULL) {
+		for (typename Entries::const_iterator iter = entries->begin(); iter != entries->end(); ++iter) {
+			if (EqualGridPoint()(iter->location, location))
+				out.push_back(iter->agent);
+		}
+	}
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+bool BinnedMultipleOccupancy<T, GPType, N>::put(boost::shared_ptr<T>& agent, const Point<GPType, M>& location) {
+	Entries* entries = bin(location, true);
+	for (typename Entries::const_iterator iter = entries->begin(); iter != entries->end(); ++iter) {
+		if (iter->agent == agent.get() && EqualGridPoint()(iter->location, location))
+			return true;
+	}
+	entries->push_back(Entry(agent.get(), PointType(location)));
+	size_++;
+	return true;
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+void BinnedMultipleOccupancy<T, GPType, N>::remove(boost::shared_ptr<T>& agent, const Point<GPType, M>& location) {
+	Entries* entries = bin(location, false);
+	if (entries == NULL)
+		return;
+
+	for (typename Entries::iterator iter = entries->begin(); iter != entries->end(); ++iter) {
+		if (iter->agent == agent.get() && EqualGridPoint()(iter->location, location)) {
+			// order within a bin doesn't matter, so fill the hole from the back
+			*iter = entries->back();
+			entries->pop_back();
+			size_--;
+			break;
+		}
+	}
+
+	if (entries->empty() && !inArray(entries))
+		overflow.erase(overflowKey(location));
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<typename Visitor>
+void BinnedMultipleOccupancy<T, GPType, N>::visitEntries(const Entries& entries, const std::vector<double>& lower,
+		const std::vector<double>& upper, Visitor& visit) {
+	for (typename Entries::const_iterator iter = entries.begin(); iter != entries.end(); ++iter) {
+		size_t i = 0, n = lower.size();
+		for (; i < n; i++) {
+			double coordinate = iter->location[i];
+			if (coordinate < lower[i] || coordinate > upper[i])
+				break;
+		}
+		if (i == n)
+			visit(iter->agent, iter->location);
+	}
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<typename Visitor>
+void BinnedMultipleOccupancy<T, GPType, N>::visitBox(const std::vector<double>& lower,
+		const std::vector<double>& upper, Visitor& visit) const {
+	size_t dims = lower.size();
+	if (size_ == 0 || dims != origin.size())
+		return;
+
+	// the part of the box within the bin array
+	std::vector<int> from(dims), to(dims);
+	bool inArray = !bins.empty();
+	for (size_t i = 0; i < dims; i++) {
+		int first = binCoordinate(lower[i], i);
+		int last = binCoordinate(upper[i], i);
+		from[i] = std::max(first, 0);
+		to[i] = std::min(last, binCounts[i] - 1);
+		if (from[i] > to[i])
+			inArray = false;
+	}
+
+	if (inArray) {
+		std::vector<int> b(from);
+		while (true) {
+			size_t index = 0;
+			for (size_t i = 0; i < dims; i++)
+				index += b[i] * strides[i];
+			visitEntries(bins[index], lower, upper, visit);
+
+			size_t i = 0;
+			while (i < dims && ++b[i] > to[i]) {
+				b[i] = from[i];
+				i++;
+			}
+			if (i == dims)
+				break;
+		}
+	}
+
+	if (overflow.empty())
+		return;
+
+	// there are few overflow bins (empty ones are erased), so check each
+	// of them against the box rather than looking up every bin it covers
+	for (typename OverflowMap::const_iterator iter = overflow.begin(); iter != overflow.end(); ++iter) {
+		const std::vector<int>& key = iter->first;
+		size_t i = 0;
+		for (; i < dims; i++) {
+			if (key[i] < binCoordinate(lower[i], i) || key[i] > binCoordinate(upper[i], i))
+				break;
+		}
+		if (i == dims)
+			visitEntries(iter->second, lower, upper, visit);
+	}
+}
+
+}
+
+#endif /* BINNEDMULTIPLEOCCUPANCY_H_ */
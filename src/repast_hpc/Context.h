@@ -56,6 +56,7 @@
 #include "ValueLayer.h"
 #include "Projection.h"
 #include "RepastErrors.h"
+#include "ParallelAgents.h"
 
 namespace repast {
 
@@ -71,6 +72,33 @@ struct SecondElement: public std::unary_function<typename boost::unordered_map<A
   }
 };
 
+/**
+ * Unary predicate that accepts every agent. Used when sampling
+ * agents without a type or filter restriction.
+ */
+template<typename T>
+struct AnyAgent {
+  bool operator()(const boost::shared_ptr<T>& ptr) const {
+    return true;
+  }
+};
+
+/**
+ * Unary predicate that accepts an agent only if both of the
+ * given predicates accept it.
+ */
+template<typename T, typename FirstFilter, typename SecondFilter>
+struct BothFilters {
+  FirstFilter&  first;
+  SecondFilter& second;
+
+  BothFilters(FirstFilter& firstFilter, SecondFilter& secondFilter): first(firstFilter), second(secondFilter){ }
+
+  bool operator()(const boost::shared_ptr<T>& ptr) {
+    return first(ptr) && second(ptr);
+  }
+};
+
 
 /**
  * Collection of agents of type T with set semantics. Object identity and equality
@@ -89,12 +117,52 @@ private:
 	typedef typename AgentMap::iterator AgentMapIterator;
 	typedef typename AgentMap::const_iterator AgentMapConstIterator;
 
+	typedef typename boost::unordered_map<AgentId, std::size_t, HashId> AgentIndexMap;
+
 	AgentMap agents;
 	std::map<std::string, BaseValueLayer*> valueLayers;
 
+	/**
+	 * Dense index of the agents in this context. Kept in step with
+	 * the agent map by addAgent and removeAgent (removal swaps the last
+	 * entry into the vacated slot) so that agents can be accessed
+	 * by position in O(1) for random sampling.
+	 */
+	std::vector<boost::shared_ptr<T> > agentIndex;
+	AgentIndexMap agentIndexPositions;
+
 protected:
   std::vector<Projection<T> *> projections;
 
+	/**
+	 * Draws up to count agents uniformly at random and without replacement
+	 * from the dense agent index, appending them to out in the order drawn.
+	 * Agents in exclude, or not accepted by the predicate, are skipped and do
+	 * not count toward the total. This performs a partial Fisher-Yates shuffle
+	 * over a virtual copy of the index, so the cost is proportional to the
+	 * number of draws (count divided by the fraction of agents accepted)
+	 * rather than to size().
+	 */
+	template<typename Accept>
+	void sampleAgents(int count, const std::set<T*>& exclude, std::vector<T*>& out, Accept& accept);
+
+	/**
+	 * Implements the selectAgents(count, set, ...) family: samples up to count
+	 * accepted agents not already in the set and adds them to it, first
+	 * emptying the set if remove is true.
+	 */
+	template<typename Accept>
+	void selectSampledAgents(int count, std::set<T*>& selectedAgents, bool remove, Accept& accept);
+
+	/**
+	 * Implements the selectAgents(count, vector, ...) family: samples up to count
+	 * accepted agents not already in the vector. If remove is true the vector is
+	 * replaced by the sample; otherwise the sample is added to the original
+	 * elements and the whole vector is shuffled.
+	 */
+	template<typename Accept>
+	void selectSampledAgents(int count, std::vector<T*>& selectedAgents, bool remove, Accept& accept);
+
 public:
 
 	typedef typename boost::transform_iterator<SecondElement<T> , typename AgentMap::const_iterator> const_iterator;
@@ -164,7 +232,9 @@ public:
 
 	/**
 	 * Gets at random the specified count of agents and returns them
-	 * in the agents vector.
+	 * in the agents vector. Agents already in the vector are not
+	 * selected again. If fewer than count agents are available, all
+	 * the available agents are returned.
 	 *
 	 * @param count the number of agents to get
 	 * @param [out] agents a vector where the agents will be returned
@@ -193,6 +263,22 @@ public:
 		return const_iterator(agents.end());
 	}
 
+	/**
+	 * Calls func on each agent in this context, split across the process's
+	 * threads (see setThreadCount). Inside func, agentRandom() gives each
+	 * agent its own random stream, so the results do not depend on the
+	 * thread count; grid moves should be recorded in a DeferredMoves and
+	 * applied afterwards. See forEachAgentInParallel for what func may do.
+	 *
+	 * In a SharedContext this includes the non-local agents; to process only
+	 * the local ones, select them with SharedContext::selectAgents and pass
+	 * them to forEachAgentInParallel.
+	 *
+	 * @param func an object that implements operator()(T* agent)
+	 */
+	template<typename Functor>
+	void parallelForEach(Functor func);
+
 	/**
 	 * Gets the start of an iterator over agents in this context of the specified type. The type
 	 * corresponds to the type component of an agent's AgentId.
@@ -440,10 +526,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param [out] selectedAgents a set into which the pointers to the agents will be placed
 	 * @param type numeric type of agent to be selected
@@ -460,10 +545,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param [out] selectedAgents a vector into which the pointers to the agents will be placed
 	 * @param type numeric type of agent to be selected
@@ -483,10 +567,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param count the number of agents to be selected. If this exceeds the number
 	 * that can possibly be selected, all possible agents will be selected
@@ -508,10 +591,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param count the number of agents to be selected. If this exceeds the number
 	 * that can possibly be selected, all possible agents will be selected
@@ -529,10 +611,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * that can possibly be selected, all possible agents will be selected
 	 * @param [out] selectedAgents a set into which the pointers to the agents will be placed
@@ -554,10 +635,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param [out] selectedAgents a vector into which the pointers to the agents will be placed
 	 * @param filter user-defined filter specifying any criteria agents to be selected
@@ -581,10 +661,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param count the number of agents to be selected. If this exceeds the number
 	 * that can possibly be selected, all possible agents will be selected
@@ -610,10 +689,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param count the number of agents to be selected. If this exceeds the number
 	 * that can possibly be selected, all possible agents will be selected
@@ -636,10 +714,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param [out] selectedAgents a set into which the pointers to the agents will be placed
 	 * @param type numeric type of agent to be selected
@@ -661,10 +738,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param [out] selectedAgents a vector into which the pointers to the agents will be placed
 	 * @param type numeric type of agent to be selected
@@ -689,10 +765,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param count the number of agents to be selected. If this exceeds the number
 	 * that can possibly be selected, all possible agents will be selected
@@ -719,10 +794,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param count the number of agents to be selected. If this exceeds the number
 	 * that can possibly be selected, all possible agents will be selected
@@ -809,7 +883,51 @@ public:
    */
   void setProjectionInfo(std::map<std::string, std::vector<repast::ProjectionInfoPacket*> >& projInfo);
 
-  void cleanProjectionInfo(std::set<AgentId>& agentsToKeep);
+  /**
+   * Gets the projection information for all projections in this context, indexed by the
+   * ordinal of each projection (the order in which it was added to this context) rather
+   * than by name. This is the form exchanged between processes; it requires that every
+   * process add the same projections in the same order.
+   *
+   * @param req List of IDs for agents whose information is requested
+   * @param info vector into which the projection information will be placed, one entry
+   * per projection in this context
+   * @param secondaryInfo true if the 'secondary' projection info must also be returned
+   * @param secondaryIds A set of IDs for agents who are referred to by the projection informaton
+   * being returned (may be null)
+   * @param destProc The Process that will be receiving this information
+   */
+  void getProjectionInfo(AgentRequest req, std::vector<std::vector<repast::ProjectionInfoPacket*> >& info,
+      bool secondaryInfo = false, std::set<AgentId>* secondaryIds = 0, int destProc = -1);
+
+  /**
+   * Sets the projection information as specified.
+   *
+   * @param projInfo projection information indexed by projection ordinal, as returned by
+   * getProjectionInfo on the sending process
+   */
+  void setProjectionInfo(std::vector<std::vector<repast::ProjectionInfoPacket*> >& projInfo);
+
+  /**
+   * Returns true if every projection in this context can write its projection
+   * information as flat bytes, so that it can travel in the same raw message as
+   * trivially packable agent content.
+   */
+  bool projectionInfoIsPackable();
+
+  /**
+   * Appends a flat byte image of the projection information, indexed by projection
+   * ordinal, to the buffer. Requires projectionInfoIsPackable().
+   */
+  void packProjectionInfo(std::vector<std::vector<repast::ProjectionInfoPacket*> >& info, std::vector<char>& buffer);
+
+  /**
+   * Reads projection information written by packProjectionInfo, advancing position
+   * past it. The packets created are owned by the caller.
+   */
+  void unpackProjectionInfo(const char*& position, std::vector<std::vector<repast::ProjectionInfoPacket*> >& info);
+
+  void cleanProjectionInfo(AgentIdSet& agentsToKeep);
 
 };
 
@@ -866,22 +984,72 @@ T* Context<T>::getAgent(const AgentId& id) {
 
 template<typename T>
 void Context<T>::getRandomAgents(const int count, std::vector<T*>& agents) {
-	for (int i = 0; i < count; i++) {
-		IntUniformGenerator rnd = Random::instance()->createUniIntGenerator(0, size() - 1);
-		bool found = false;
-		while (!found) {
-			const_iterator iter = begin();
-			for (int j = 0, n = rnd.next(); j < n; iter++, j++)
-				;
-			T* agent = iter->get();
-			if (find(agents.begin(), agents.end(), agent) == agents.end()) {
-				agents.push_back(agent);
-				found = true;
-			}
+	std::set<T*> exclude(agents.begin(), agents.end());
+	AnyAgent<T> any;
+	sampleAgents(count, exclude, agents, any);
+}
+
+template<typename T>
+template<typename Functor>
+void Context<T>::parallelForEach(Functor func) {
+	std::vector<T*> targets;
+	targets.reserve(agentIndex.size());
+	for (size_t i = 0; i < agentIndex.size(); i++) targets.push_back(agentIndex[i].get());
+	forEachAgentInParallel(targets, func);
+}
+
+template<typename T>
+template<typename Accept>
+void Context<T>::sampleAgents(int count, const std::set<T*>& exclude, std::vector<T*>& out, Accept& accept) {
+	int n = agentIndex.size();
+	if (count <= 0 || n == 0) return;
+
+	// Slots displaced by the virtual swaps; a slot not in the map holds its own index
+	boost::unordered_map<int, int> swapped;
+	Random* random = Random::instance();
+	int added = 0;
+	for (int i = 0; i < n && added < count; i++) {
+		int j = i + (int) (random->nextDouble() * (n - i));
+		boost::unordered_map<int, int>::iterator found = swapped.find(i);
+		int atI = (found == swapped.end() ? i : found->second);
+		found = swapped.find(j);
+		int atJ = (found == swapped.end() ? j : found->second);
+		swapped[j] = atI;
+
+		const boost::shared_ptr<T>& agent = agentIndex[atJ];
+		if ((exclude.empty() || exclude.find(agent.get()) == exclude.end()) && accept(agent)) {
+			out.push_back(agent.get());
+			added++;
 		}
 	}
 }
 
+template<typename T>
+template<typename Accept>
+void Context<T>::selectSampledAgents(int count, std::set<T*>& selectedAgents, bool remove, Accept& accept){
+	std::vector<T*> sampled;
+	sampleAgents(count, selectedAgents, sampled, accept);
+	if(remove) selectedAgents.clear();
+	selectedAgents.insert(sampled.begin(), sampled.end());
+}
+
+template<typename T>
+template<typename Accept>
+void Context<T>::selectSampledAgents(int count, std::vector<T*>& selectedAgents, bool remove, Accept& accept){
+	std::set<T*> exclude(selectedAgents.begin(), selectedAgents.end());
+	std::vector<T*> sampled;
+	sampleAgents(count, exclude, sampled, accept);
+	if(remove || exclude.empty()){
+	  // Already in random order
+	  selectedAgents.swap(sampled);
+	}
+	else{
+	  selectedAgents.assign(exclude.begin(), exclude.end());
+	  selectedAgents.insert(selectedAgents.end(), sampled.begin(), sampled.end());
+	  shuffleList(selectedAgents);
+	}
+}
+
 template<typename T>
 T* Context<T>::addAgent(T* agent) {
 	const AgentId& id = agent->getId();
@@ -890,6 +1058,8 @@ T* Context<T>::addAgent(T* agent) {
 
 	boost::shared_ptr<T> ptr(agent);
 	agents[id] = ptr;
+	agentIndexPositions[id] = agentIndex.size();
+	agentIndex.push_back(ptr);
 
 	for (ProjPtrIter iter = projections.begin(); iter != projections.end(); ++iter) {
 		Projection<T>* proj = *iter;
@@ -913,6 +1083,15 @@ void Context<T>::removeAgent(const AgentId id) {
 			Projection<T>* proj = *pIter;
 			proj->removeAgent(ptr.get());
 		}
+
+		typename AgentIndexMap::iterator posIter = agentIndexPositions.find(id);
+		std::size_t pos = posIter->second;
+		boost::shared_ptr<T> last = agentIndex.back();
+		agentIndex[pos] = last;
+		agentIndexPositions[last->getId()] = pos;
+		agentIndex.pop_back();
+		agentIndexPositions.erase(posIter);
+
 		agents.erase(iter);
 	}
 }
@@ -986,102 +1165,108 @@ boost::filter_iterator<filterStruct, typename Context<T>::const_bytype_iterator>
 	
 template<typename T>
 void Context<T>::selectAgents(std::set<T*>& selectedAgents, bool remove){
-	selectNElementsAtRandom(begin(), size(), size(), selectedAgents, remove);
+	selectAgents(size(), selectedAgents, remove);
 }
 	
 template<typename T>
 void Context<T>::selectAgents(std::vector<T*>& selectedAgents, bool remove){
-	selectNElementsInRandomOrder(begin(), size(), size(), selectedAgents, remove);
+	selectAgents(size(), selectedAgents, remove);
 }
 	
 template<typename T>
 void Context<T>::selectAgents(int count, std::set<T*>& selectedAgents, bool remove){
-	selectNElementsAtRandom(begin(), size(), count, selectedAgents, remove);
+	AnyAgent<T> any;
+	selectSampledAgents(count, selectedAgents, remove, any);
 }
 	
 template<typename T>
 void Context<T>::selectAgents(int count, std::vector<T*>& selectedAgents, bool remove){
-	selectNElementsInRandomOrder(begin(), end(), count, selectedAgents, remove);
+	AnyAgent<T> any;
+	selectSampledAgents(count, selectedAgents, remove, any);
 }
 	
 template<typename T>
 void Context<T>::selectAgents(std::set<T*>& selectedAgents, int type, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(byTypeBegin(type), byTypeEnd(type), size(), selectedAgents, remove);
-	else              selectNElementsAtRandom(byTypeBegin(type), popSize, size(), selectedAgents, remove);
+	IsAgentType<T> accept(type);
+	selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 	
 template<typename T>
 void Context<T>::selectAgents(std::vector<T*>& selectedAgents, int type, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(byTypeBegin(type), byTypeEnd(type), size(), selectedAgents, remove);
-	else              selectNElementsInRandomOrder(byTypeBegin(type), popSize, size(), selectedAgents, remove);
+	IsAgentType<T> accept(type);
+	selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 	
 template<typename T>
 void Context<T>::selectAgents(int count, std::set<T*>& selectedAgents, int type, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(byTypeBegin(type), byTypeEnd(type), count, selectedAgents, remove);
-	else              selectNElementsAtRandom(byTypeBegin(type), popSize, count, selectedAgents, remove);
+	IsAgentType<T> accept(type);
+	selectSampledAgents(count, selectedAgents, remove, accept);
 }
 	
 template<typename T>
 void Context<T>::selectAgents(int count, std::vector<T*>& selectedAgents, int type, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(byTypeBegin(type), byTypeEnd(type), count, selectedAgents, remove);
-	else              selectNElementsInRandomOrder(byTypeBegin(type), popSize, count, selectedAgents, remove);
+	IsAgentType<T> accept(type);
+	selectSampledAgents(count, selectedAgents, remove, accept);
 }
 	
 template<typename T>
 template<typename filterStruct>
 void Context<T>::selectAgents(std::set<T*>& selectedAgents, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(filteredBegin<filterStruct>(filter), filteredEnd<filterStruct>(filter), size(), selectedAgents, remove);
-	else              selectNElementsAtRandom(filteredBegin<filterStruct>(filter), popSize, size(), selectedAgents, remove);
+	filterStruct& accept = filter;
+	selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 	
 template<typename T>
 template<typename filterStruct>
 void Context<T>::selectAgents(std::vector<T*>& selectedAgents, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(filteredBegin(filter), filteredEnd(filter), size(), selectedAgents, remove);
-	else              selectNElementsInRandomOrder(filteredBegin(filter), popSize, size(), selectedAgents, remove);
+	filterStruct& accept = filter;
+	selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 	
 template<typename T>
 template<typename filterStruct>
 void Context<T>::selectAgents(int count, std::set<T*>& selectedAgents, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(filteredBegin<filterStruct>(filter), filteredEnd<filterStruct>(filter), count, selectedAgents, remove);
-	else              selectNElementsAtRandom(filteredBegin<filterStruct>(filter), popSize, count, selectedAgents, remove);
+	filterStruct& accept = filter;
+	selectSampledAgents(count, selectedAgents, remove, accept);
 }
 	
 template<typename T>
 template<typename filterStruct>
 void Context<T>::selectAgents(int count, std::vector<T*>& selectedAgents, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(filteredBegin(filter), filteredEnd(filter), count, selectedAgents, remove);
-	else              selectNElementsInRandomOrder(filteredBegin(filter), popSize, count, selectedAgents, remove);
+	filterStruct& accept = filter;
+	selectSampledAgents(count, selectedAgents, remove, accept);
 }
 	
 template<typename T>
 template<typename filterStruct>
 void Context<T>::selectAgents(std::set<T*>& selectedAgents, int type, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(byTypeFilteredBegin(type, filter), byTypeFilteredEnd(type, filter), size(), selectedAgents, remove);
-	else              selectNElementsAtRandom(byTypeFilteredBegin(type, filter), popSize, size(), selectedAgents, remove);
+	IsAgentType<T> isType(type);
+	BothFilters<T, IsAgentType<T>, filterStruct> accept(isType, filter);
+	selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 	
 template<typename T>
 template<typename filterStruct>
 void Context<T>::selectAgents(std::vector<T*>& selectedAgents, int type, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(byTypeFilteredBegin(type, filter), byTypeFilteredEnd(type, filter), size(), selectedAgents, remove);
-	else              selectNElementsInRandomOrder(byTypeFilteredBegin(type, filter), popSize, size(), selectedAgents, remove);
+	IsAgentType<T> isType(type);
+	BothFilters<T, IsAgentType<T>, filterStruct> accept(isType, filter);
+	selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 	
 template<typename T>
 template<typename filterStruct>
 void Context<T>::selectAgents(int count, std::set<T*>& selectedAgents, int type, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(byTypeFilteredBegin(type, filter), byTypeFilteredEnd(type, filter), count, selectedAgents, remove);
-	else              selectNElementsAtRandom(byTypeFilteredBegin(type, filter), popSize, count, selectedAgents, remove);
+	IsAgentType<T> isType(type);
+	BothFilters<T, IsAgentType<T>, filterStruct> accept(isType, filter);
+	selectSampledAgents(count, selectedAgents, remove, accept);
 }
 	
 template<typename T>
 template<typename filterStruct>
 void Context<T>::selectAgents(int count, std::vector<T*>& selectedAgents, int type, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(byTypeFilteredBegin(type, filter), byTypeFilteredEnd(type, filter), count, selectedAgents, remove);
-	else              selectNElementsInRandomOrder(byTypeFilteredBegin(type, filter), popSize, count, selectedAgents, remove);
+	IsAgentType<T> isType(type);
+	BothFilters<T, IsAgentType<T>, filterStruct> accept(isType, filter);
+	selectSampledAgents(count, selectedAgents, remove, accept);
 }
 
 
@@ -1105,7 +1290,63 @@ void Context<T>::setProjectionInfo(std::map<std::string, std::vector<repast::Pro
 }
 
 template<typename T>
-void Context<T>::cleanProjectionInfo(std::set<AgentId>& agentsToKeep){
+void Context<T>::getProjectionInfo(AgentRequest req, std::vector<std::vector<repast::ProjectionInfoPacket*> >& info,
+    bool secondaryInfo, std::set<AgentId>* secondaryIds, int destProc){
+  std::vector<AgentId> ids = req.requestedAgents();
+  info.resize(projections.size());
+  for(size_t i = 0; i < projections.size(); i++){
+    projections[i]->getProjectionInfo(ids, info[i], secondaryInfo, secondaryIds, destProc);
+  }
+}
+
+template<typename T>
+void Context<T>::setProjectionInfo(std::vector<std::vector<repast::ProjectionInfoPacket*> >& projInfo){
+  if(projInfo.size() > projections.size()) throw Repast_Error_58(projInfo.size(), projections.size());
+  for(size_t i = 0; i < projInfo.size(); i++)
+      projections[i]->updateProjectionInfo(projInfo[i], this);
+}
+
+template<typename T>
+bool Context<T>::projectionInfoIsPackable(){
+  for(size_t i = 0; i < projections.size(); i++){
+    if(!projections[i]->projectionInfoIsPackable()) return false;
+  }
+  return true;
+}
+
+template<typename T>
+void Context<T>::packProjectionInfo(std::vector<std::vector<repast::ProjectionInfoPacket*> >& info, std::vector<char>& buffer){
+  // Projection count, then for each projection its packet count followed by its packets
+  int count = info.size();
+  size_t offset = buffer.size();
+  buffer.resize(offset + sizeof(int));
+  memcpy(&buffer[offset], &count, sizeof(int));
+  for(size_t i = 0; i < info.size(); i++){
+    count = info[i].size();
+    offset = buffer.size();
+    buffer.resize(offset + sizeof(int));
+    memcpy(&buffer[offset], &count, sizeof(int));
+    for(size_t j = 0; j < info[i].size(); j++) projections[i]->packProjectionInfo(info[i][j], buffer);
+  }
+}
+
+template<typename T>
+void Context<T>::unpackProjectionInfo(const char*& position, std::vector<std::vector<repast::ProjectionInfoPacket*> >& info){
+  int count;
+  memcpy(&count, position, sizeof(int));
+  position += sizeof(int);
+  if(count > (int)projections.size()) throw Repast_Error_58(count, projections.size());
+  info.resize(count);
+  for(int i = 0; i < count; i++){
+    int packets;
+    memcpy(&packets, position, sizeof(int));
+    position += sizeof(int);
+    for(int j = 0; j < packets; j++) info[i].push_back(projections[i]->unpackProjectionInfo(position));
+  }
+}
+
+template<typename T>
+void Context<T>::cleanProjectionInfo(AgentIdSet& agentsToKeep){
   for(typename std::vector<Projection<T> *>::iterator iter = projections.begin(), iterEnd = projections.end(); iter != iterEnd; iter++){
       (*iter)->cleanProjectionInfo(agentsToKeep);
   }
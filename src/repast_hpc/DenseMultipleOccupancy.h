@@ -0,0 +1,242 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  DenseMultipleOccupancy.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef DENSEMULTIPLEOCCUPANCY_H_
+#define DENSEMULTIPLEOCCUPANCY_H_
+
+#include <vector>
+#include <algorithm>
+
+#include <type_traits>
+
+#include <boost/shared_ptr.hpp>
+
+#include "Point.h"
+#include "GridDimensions.h"
+#include "MultipleOccupancy.h"
+
+namespace repast {
+
+/**
+ * Multiple occupancy cell accessor for dense discrete grids. The cells
+ * within the bounds passed to init are held in a flat array, each with a
+ * compact vector of its occupants, so finding a cell is arithmetic rather
+ * than a hash lookup and the occupants are copied out directly. A cell's
+ * vector keeps its capacity when agents leave, so agents moving around
+ * the bounds do not allocate once the cells have warmed up. Locations
+ * outside the bounds (e.g. agents that have moved off this process but
+ * not yet been synchronized) are held in a MultipleOccupancy.
+ *
+ * SharedBaseGrid initializes the accessor with its local bounds plus the
+ * buffer. Occupants of a cell are returned in the order they arrived. Cells
+ * hold raw pointers; the grid's own shared_ptr keeps each agent alive while
+ * it is placed.
+ *
+ * @param T the type of object in the Grid
+ * @param GPType the coordinate type of the grid point locations. This must
+ * be an integral type.
+ * @param N the dimension count of the Point<GPType, N> locations outside the
+ * bounds are keyed on, or 0 for the dynamically sized Point<GPType>.
+ */
+template<typename T, typename GPType, std::size_t N = 0>
+class DenseMultipleOccupancy {
+
+	static_assert(std::is_integral<GPType>::value, "DenseMultipleOccupancy requires discrete coordinates");
+
+public:
+
+	/**
+	 * The type of point locations outside the bounds are keyed on.
+	 */
+	typedef Point<GPType, N> PointType;
+
+private:
+	typedef std::vector<T*> Occupants;
+
+	std::vector<Occupants> cells;
+	std::vector<GPType> origin, extents;
+	std::vector<size_t> strides;
+
+	MultipleOccupancy<T, GPType, N> overflow;
+
+	template<std::size_t M>
+	Occupants* cell(const Point<GPType, M>& location);
+
+	template<std::size_t M>
+	const Occupants* cell(const Point<GPType, M>& location) const {
+		return const_cast<DenseMultipleOccupancy*> (this)->cell(location);
+	}
+
+public:
+
+	/**
+	 * Sizes the cell array to cover the specified bounds. Any occupants
+	 * must be removed before calling this.
+	 *
+	 * @param bounds the bounds to hold in the cell array
+	 */
+	void init(const GridDimensions& bounds);
+
+	/**
+	 * Gets the number of cells in the cell array.
+	 */
+	size_t cellCount() const {
+		return cells.size();
+	}
+
+	/**
+	 * Gets the first object found at the specified location.
+	 *
+	 * @param location the location to get the object at
+	 * @return the first object found at the specified location or 0 if there
+	 * are no objects at the specified location.
+	 */
+	template<std::size_t M>
+	T* get(const Point<GPType, M>& location) const;
+
+	/**
+	 * Gets all the items found at the specified location.
+	 *
+	 * @param location the location to get the items at
+	 * @param [out] the found items will be appended to this vector
+	 */
+	template<std::size_t M>
+	void getAll(const Point<GPType, M>& location, std::vector<T*>& out) const;
+
+	/**
+	 * Puts the specified item at the specified location.
+	 *
+	 * @param agent the item to put
+	 * @param location the location to put the item at
+	 */
+	template<std::size_t M>
+	bool put(boost::shared_ptr<T>& agent, const Point<GPType, M>& location);
+
+	/**
+	 * Removes the specified item from the specified location.
+	 *
+	 * @param agent the item to remove
+	 * @param location the location to remove the item from
+	 */
+	template<std::size_t M>
+	void remove(boost::shared_ptr<T>& agent, const Point<GPType, M>& location);
+
+};
+
+template<typename T, typename GPType, std::size_t N>
+void DenseMultipleOccupancy<T, GPType, N>::init(const GridDimensions& bounds) {
+	size_t dims = bounds.dimensionCount();
+	origin.assign(dims, 0);
+	extents.assign(dims, 0);
+	strides.assign(dims, 0);
+
+	size_t count = 1;
+	for (size_t i = 0; i < dims; i++) {
+		origin[i] = (GPType) bounds.origin(i);
+		extents[i] = (GPType) bounds.extents(i);
+		strides[i] = count;
+		count *= extents[i];
+	}
+	std::vector<Occupants>(count).swap(cells);
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+typename DenseMultipleOccupancy<T, GPType, N>::Occupants* DenseMultipleOccupancy<T, GPType, N>::cell(
+		const Point<GPType, M>& location) {
+	if (cells.empty() || location.dimensionCount() != origin.size())
+		return NULL;
+
+	size_t index = 0;
+	for (size_t i = 0, n = origin.size(); i < n; i++) {
+		GPType offset = location[i] - origin[i];
+		if (offset < 0 || offset >= extents[i])
+			return NULL;
+		index += offset * strides[i];
+	}
+	return &cells[index];
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+T* DenseMultipleOccupancy<T, GPType, N>::get(const Point<GPType, M>& location) const {
+	const Occupants* occupants = cell(location);
+	if (occupants == NULL)
+		return overflow.get(location);
+	return occupants->empty() ? NULL : occupants->front();
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+void DenseMultipleOccupancy<T, GPType, N>::getAll(const Point<GPType, M>& location, std::vector<T*>& out) const {
+	const Occupants* occupants = cell(location);
+	if (occupants == NULL)
+		overflow.getAll(location, out);
+	else
+		out.insert(out.end(), occupants->begin(), occupants->end());
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+bool DenseMultipleOccupancy<T, GPType, N>::put(boost::shared_ptr<T>& agent, const Point<GPType, M>& location) {
+	Occupants* occupants = cell(location);
+	if (occupants == NULL)
+		return overflow.put(agent, location);
+
+	if (std::find(occupants->begin(), occupants->end(), agent.get()) == occupants->end())
+		occupants->push_back(agent.get());
+	return true;
+}
+
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+void DenseMultipleOccupancy<T, GPType, N>::remove(boost::shared_ptr<T>& agent, const Point<GPType, M>& location) {
+	Occupants* occupants = cell(location);
+	if (occupants == NULL) {
+		overflow.remove(agent, location);
+	} else {
+		typename Occupants::iterator iter = std::find(occupants->begin(), occupants->end(), agent.get());
+		if (iter != occupants->end())
+			occupants->erase(iter);
+	}
+}
+
+}
+
+#endif /* DENSEMULTIPLEOCCUPANCY_H_ */
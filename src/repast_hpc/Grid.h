@@ -95,6 +95,20 @@ public:
 	 */
 	virtual bool moveTo(const AgentId& id, const Point<GPType>& pt) = 0;
 
+	/**
+	 * Moves the specified agent to the specified two dimensional point.
+	 * Grids that can move agents without allocating a dynamic Point
+	 * override this; by default the point is converted.
+	 *
+	 * @param id the id of the agent to move
+	 * @param pt where to move the agent to
+	 *
+	 * @return true if the move was successful, otherwise false
+	 */
+	virtual bool moveTo(const AgentId& id, const Point<GPType, 2>& pt) {
+		return moveTo(id, Point<GPType> (pt));
+	}
+
 	/**
 	 * Moves the specifed object the specified distance from its current
 	 * position along the specified angle. For example, <code>moveByVector(object, 1, Grid.NORTH)</code>
@@ -153,6 +167,14 @@ public:
 	 */
 	virtual T* getObjectAt(const Point<GPType>& pt) const = 0;
 
+	/**
+	 * Gets the first object found at the specified two dimensional point,
+	 * or NULL if there is no such object. By default the point is converted.
+	 */
+	virtual T* getObjectAt(const Point<GPType, 2>& pt) const {
+		return getObjectAt(Point<GPType> (pt));
+	}
+
 	/**
 	 * Gets all the objects found at the specified point. The found objects
 	 * will be put into the out parameter.
@@ -162,6 +184,18 @@ public:
 	 */
 	virtual void getObjectsAt(const Point<GPType>& pt, std::vector<T*>& out) const = 0;
 
+	/**
+	 * Gets all the objects found at the specified two dimensional point. This
+	 * is the lookup used by the 2D neighborhood queries; by default the point
+	 * is converted.
+	 *
+	 * @param pt the point to get all the objects at
+	 * @param [out] out the vector into which the found objects will be put
+	 */
+	virtual void getObjectsAt(const Point<GPType, 2>& pt, std::vector<T*>& out) const {
+		getObjectsAt(Point<GPType> (pt), out);
+	}
+
 	/**
 	 * Gets the location of this agent and puts it in the
 	 * specified vector. The x coordinate will be the first value,
@@ -227,6 +261,21 @@ public:
 	virtual void
 	translate(const Point<GPType>& location, const Point<GPType>& displacement, std::vector<GPType>& out) const = 0;
 
+	/**
+	 * Translates the specified two dimensional location by the specified
+	 * displacement and puts the result in out. By default the points are converted.
+	 *
+	 * @param location the initial location
+	 * @param displacement the amount to translate the location by
+	 * @param [out] out the point where the result of the translation is put
+	 */
+	virtual void translate(const Point<GPType, 2>& location, const Point<GPType, 2>& displacement,
+			Point<GPType, 2>& out) const {
+		std::vector<GPType> translated(2, 0);
+		translate(Point<GPType> (location), Point<GPType> (displacement), translated);
+		out = Point<GPType, 2> (translated);
+	}
+
 	/**
 	 * Transforms the specified location using the properties (e.g. toroidal) of this space.
 	 *
@@ -236,6 +285,20 @@ public:
 	virtual void
 	transform(const std::vector<GPType>& location, std::vector<GPType>& out) const = 0;
 
+	/**
+	 * Transforms the specified two dimensional location using the properties
+	 * (e.g. toroidal) of this space. By default the point is converted.
+	 *
+	 * @param location the location to transform
+	 * @param [out] out the point where the result of the transform will be put
+	 */
+	virtual void transform(const Point<GPType, 2>& location, Point<GPType, 2>& out) const {
+		std::vector<GPType> coords, transformed(2, 0);
+		location.copy(coords);
+		transform(coords, transformed);
+		out = Point<GPType, 2> (transformed);
+	}
+
 	/**
 	 * Gets whether or not this grid is periodic (i.e. toroidal).
 	 *
@@ -247,9 +310,9 @@ public:
 
   virtual void updateProjectionInfo(ProjectionInfoPacket* pip, Context<T>* context) = 0;
 
-  virtual void getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsRequired, RADIUS radius = Projection<T>::PRIMARY){} // Grids allow all agents to be dropped b/c agent info not dependent on other agents
+  virtual void getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsRequired, RADIUS radius = Projection<T>::PRIMARY){} // Grids allow all agents to be dropped b/c agent info not dependent on other agents
 
-  virtual void getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush) = 0;
+  virtual void getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush) = 0;
 
   virtual bool keepsAgentsOnSyncProj(){ return false; }
 
@@ -259,7 +322,7 @@ public:
 
   virtual void getAgentStatusExchangePartners(std::set<int>& psToSendTo, std::set<int>& psToReceiveFrom) = 0;
 
-  virtual void cleanProjectionInfo(std::set<AgentId>& agentsToKeep){}; // Grids don't do this
+  virtual void cleanProjectionInfo(AgentIdSet& agentsToKeep){}; // Grids don't do this
 
 };
 
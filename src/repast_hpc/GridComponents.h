@@ -62,17 +62,38 @@ protected:
 	void boundsCheck(const std::vector<int>& pt) const;
 	void boundsCheck(const std::vector<double>& pt) const;
 
+	template<typename T, std::size_t N>
+	void boundsCheck(const Point<T, N>& pt) const;
+
 public:
 	Borders(GridDimensions d);
 
 	void transform(const std::vector<int>& in, std::vector<int>& out) const;
 	void transform(const std::vector<double>& in, std::vector<double>& out) const;
 
+	template<typename T, std::size_t N>
+	void transform(const Point<T, N>& in, Point<T, N>& out) const;
+
 	bool isPeriodic() const {
 		return false;
 	}
 };
 
+template<typename T, std::size_t N>
+void Borders::boundsCheck(const Point<T, N>& pt) const {
+	if (!_dimensions.contains(pt)) {
+		std::vector<T> coords;
+		pt.copy(coords);
+		boundsCheck(coords);
+	}
+}
+
+template<typename T, std::size_t N>
+void Borders::transform(const Point<T, N>& in, Point<T, N>& out) const {
+	boundsCheck(in);
+	out = in;
+}
+
 /**
  * Implements strict grid border semantics: anything
  * outside the dimensions is out of bounds.
@@ -85,6 +106,12 @@ public:
 	void translate(const std::vector<double>& oldPos, std::vector<double>& newPos, const std::vector<double>& displacement) const;
 	void translate(const std::vector<int>& oldPos, std::vector<int>& newPos, const std::vector<int>& displacement) const;
 
+	template<typename T, std::size_t N>
+	void translate(const Point<T, N>& oldPos, Point<T, N>& newPos, const Point<T, N>& displacement) const {
+		for (size_t i = 0; i < N; ++i) newPos[i] = oldPos[i] + displacement[i];
+		boundsCheck(newPos);
+	}
+
 };
 
 /**
@@ -105,6 +132,11 @@ public:
 	StickyBorders(GridDimensions d);
 	void translate(const std::vector<double>& oldPos, std::vector<double>& newPos, const std::vector<double>& displacement) const;
 	void translate(const std::vector<int>& oldPos, std::vector<int>& newPos, const std::vector<int>& displacement) const;
+
+	template<typename T, std::size_t N>
+	void translate(const Point<T, N>& oldPos, Point<T, N>& newPos, const Point<T, N>& displacement) const {
+		for (size_t i = 0; i < N; ++i) newPos[i] = calcCoord<T>(oldPos[i] + displacement[i], i);
+	}
 };
 
 template<typename T>
@@ -126,12 +158,26 @@ private:
 	GridDimensions _dimensions;
 	std::vector<int> mins, maxs;
 
+	int wrap(int coord, size_t dimension) const;
+	double wrap(double coord, size_t dimension) const;
+
 public:
 
 	WrapAroundBorders(GridDimensions dimensions);
 
 	void transform(const std::vector<int>& in, std::vector<int>& out) const;
 	void transform(const std::vector<double>& in, std::vector<double>& out) const;
+
+	template<typename T, std::size_t N>
+	void transform(const Point<T, N>& in, Point<T, N>& out) const {
+		for (size_t i = 0; i < N; ++i) out[i] = wrap(in[i], i);
+	}
+
+	template<typename T, std::size_t N>
+	void translate(const Point<T, N>& oldPos, Point<T, N>& newPos, const Point<T, N>& displacement) const {
+		for (size_t i = 0; i < N; ++i) newPos[i] = wrap(oldPos[i] + displacement[i], i);
+	}
+
 	void translate(const std::vector<double>& oldPos, std::vector<double>& newPos, const std::vector<double>& displacement) const;
 	void translate(const std::vector<int>& oldPos, std::vector<int>& newPos, const std::vector<int>& displacement) const;
 
@@ -77,6 +77,12 @@ public:
 	bool contains(const Point<double>& pt) const;
 	bool contains(const std::vector<double>& pt) const;
 
+	/**
+	 * Checks a fixed dimension point without copying its coordinates.
+	 */
+	template<typename T, std::size_t N>
+	bool contains(const Point<T, N>& pt) const;
+
 	/**
 	 * Gets the origin.
 	 */
@@ -105,6 +111,23 @@ public:
 
 };
 
+template<typename T, std::size_t N>
+bool GridDimensions::contains(const Point<T, N>& pt) const {
+	if (N != _origin.dimensionCount()) {
+		std::vector<T> coords;
+		pt.copy(coords);
+		return contains(coords); // throws on the dimension mismatch
+	}
+
+	for (size_t i = 0; i < N; i++) {
+		double start = _origin[i];
+		double end = start + _extents[i];
+		if (pt[i] < start || pt[i] >= end)
+			return false;
+	}
+	return true;
+}
+
 bool operator==(const GridDimensions &one, const GridDimensions &two);
 bool operator!=(const GridDimensions &one, const GridDimensions &two);
 std::ostream& operator<<(std::ostream& os, const GridDimensions& dimensions);
@@ -107,14 +107,14 @@ void Moore2DGridQuery<T>::query(const Point<int>& center, int range, bool includ
 	if (includeCenter) {
 		for (int x = xMin; x < xMax; x++) {
 			for (int y = yMin; y < yMax; y++) {
-				Grid2DQuery<T>::_grid->getObjectsAt(Point<int> (x, y), out);
+				Grid2DQuery<T>::_grid->getObjectsAt(Point<int, 2> (x, y), out);
 			}
 		}
 	} else {
 		for (int x = xMin; x < xMax; x++) {
 			for (int y = yMin; y < yMax; y++) {
 				if (!(x == center[0] && y == center[1])) {
-					Grid2DQuery<T>::_grid->getObjectsAt(Point<int> (x, y), out);
+					Grid2DQuery<T>::_grid->getObjectsAt(Point<int, 2> (x, y), out);
 				}
 			}
 		}
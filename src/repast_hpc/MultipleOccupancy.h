@@ -45,6 +45,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include "Point.h"
+#include "GridDimensions.h"
 
 namespace repast {
 
@@ -67,26 +68,43 @@ struct ExtractPtrs: public std::unary_function<
  * @param T the type of object in the Grid
  * @param GPType the coordinate type of the grid point locations. This must
  * be an int or a double.
+ * @param N the dimension count of the Point<GPType, N> locations are keyed
+ * on, or 0 for the dynamically sized Point<GPType>. Lookups accept either kind
+ * of point whatever N is.
  */
-template<typename T, typename GPType>
+template<typename T, typename GPType, std::size_t N = 0>
 class MultipleOccupancy {
 
+public:
+
+	/**
+	 * The type of point locations are keyed on.
+	 */
+	typedef Point<GPType, N> PointType;
+
 private:
 	typedef typename boost::unordered_map<AgentId, boost::shared_ptr<T>, HashId> ValueType;
 	typedef typename ValueType::iterator ValueTypeIter;
-	typedef typename boost::unordered_map<Point<GPType> , ValueType*, HashGridPoint<GPType> > LocationMap;
+	typedef typename boost::unordered_map<PointType, ValueType*, HashGridPoint<GPType, N> > LocationMap;
 
 	typedef typename LocationMap::iterator LocationMapIter;
 	typedef typename LocationMap::const_iterator LocationMapConstIter;
 
 	LocationMap locations;
 
-	ValueType* doGet(const Point<GPType>& location) const;
+	template<std::size_t M>
+	ValueType* doGet(const Point<GPType, M>& location) const;
 
 public:
 
 	virtual ~MultipleOccupancy();
 
+	/**
+	 * Locations are held in an unbounded map, so there is nothing to size.
+	 */
+	void init(const GridDimensions& bounds) {
+	}
+
 	/**
 	 * Gets the first object found at the specified location.
 	 *
@@ -94,7 +112,8 @@ public:
 	 * @return the first object found at the specified location or 0 if there
 	 * are no objects at the specified location.
 	 */
-	T* get(const Point<GPType>& location) const;
+	template<std::size_t M>
+	T* get(const Point<GPType, M>& location) const;
 
 	/**
 	 * Gets all the items found at the specified location.
@@ -102,7 +121,8 @@ public:
 	 * @param location the location to get the items at
 	 * @param [out] the found items will be returned in this vector
 	 */
-	void getAll(const Point<GPType>& location, std::vector<T*>& out) const;
+	template<std::size_t M>
+	void getAll(const Point<GPType, M>& location, std::vector<T*>& out) const;
 
 	/**
 	 * Puts the specified item at the specified location.
@@ -110,7 +130,8 @@ public:
 	 * @param agent the item to put
 	 * @param location the location to put the item at
 	 */
-	bool put(boost::shared_ptr<T>& agent, const Point<GPType>& location);
+	template<std::size_t M>
+	bool put(boost::shared_ptr<T>& agent, const Point<GPType, M>& location);
 
 	/**
 	 * Removes the specified item from the specified location.
@@ -118,35 +139,39 @@ public:
 	 * @param agent the item to remove
 	 * @param location the location to remove the item from
 	 */
-	void remove(boost::shared_ptr<T>& agent, const Point<GPType>& location);
+	template<std::size_t M>
+	void remove(boost::shared_ptr<T>& agent, const Point<GPType, M>& location);
 
 };
 
-template<typename T, typename GPType>
-MultipleOccupancy<T, GPType>::~MultipleOccupancy() {
+template<typename T, typename GPType, std::size_t N>
+MultipleOccupancy<T, GPType, N>::~MultipleOccupancy() {
 	for (LocationMapIter iter = locations.begin(); iter != locations.end(); ++iter) {
 		delete iter->second;
 	}
 }
 
-template<typename T, typename GPType>
-typename MultipleOccupancy<T, GPType>::ValueType* MultipleOccupancy<T, GPType>::doGet(const Point<GPType>& location) const {
-	LocationMapConstIter iter = locations.find(location);
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+typename MultipleOccupancy<T, GPType, N>::ValueType* MultipleOccupancy<T, GPType, N>::doGet(const Point<GPType, M>& location) const {
+	LocationMapConstIter iter = locations.find(location, HashGridPoint<GPType, M>(), EqualGridPoint());
 	if (iter == locations.end())
 		return NULL;
 	return iter->second;
 }
 
-template<typename T, typename GPType>
-T* MultipleOccupancy<T, GPType>::get(const Point<GPType>& location) const {
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+T* MultipleOccupancy<T, GPType, N>::get(const Point<GPType, M>& location) const {
 	ValueType* ptrs = doGet(location);
 	if (ptrs == NULL)
 		return NULL;
 	return ptrs->begin()->second.get();
 }
 
-template<typename T, typename GPType>
-void MultipleOccupancy<T, GPType>::getAll(const Point<GPType>& location, std::vector<T*>& out) const {
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+void MultipleOccupancy<T, GPType, N>::getAll(const Point<GPType, M>& location, std::vector<T*>& out) const {
   ValueType* ptrs = doGet(location);
 	if (ptrs != NULL) {
 		int index = out.size();
@@ -156,13 +181,14 @@ void MultipleOccupancy<T, GPType>::getAll(const Point<GPType>& location, std::ve
 	}
 }
 
-template<typename T, typename GPType>
-bool MultipleOccupancy<T, GPType>::put(boost::shared_ptr<T>& agent, const Point<GPType>& location) {
-	LocationMapIter iter = locations.find(location);
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+bool MultipleOccupancy<T, GPType, N>::put(boost::shared_ptr<T>& agent, const Point<GPType, M>& location) {
+	LocationMapIter iter = locations.find(location, HashGridPoint<GPType, M>(), EqualGridPoint());
 	ValueType* vec;
 	if (iter == locations.end()) {
 		vec = new ValueType();
-		locations[location] = vec;
+		locations[PointType(location)] = vec;
 	} else {
 		vec = iter->second;
 	}
@@ -171,9 +197,10 @@ bool MultipleOccupancy<T, GPType>::put(boost::shared_ptr<T>& agent, const Point<
 	return true;
 }
 
-template<typename T, typename GPType>
-void MultipleOccupancy<T, GPType>::remove(boost::shared_ptr<T>& agent, const Point<GPType>& location) {
-	LocationMapIter iter = locations.find(location);
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+void MultipleOccupancy<T, GPType, N>::remove(boost::shared_ptr<T>& agent, const Point<GPType, M>& location) {
+	LocationMapIter iter = locations.find(location, HashGridPoint<GPType, M>(), EqualGridPoint());
 	if (iter != locations.end()) {
 		ValueType* vec = iter->second;
 		ValueTypeIter agentIter = vec->find(agent->getId());
@@ -0,0 +1,89 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  ParallelAgents.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "ParallelAgents.h"
+#include "RepastErrors.h"
+
+namespace repast {
+
+namespace {
+
+// The scope of the agent the thread is processing, if any
+thread_local ParallelAgentScope* currentScope = 0;
+
+}
+
+boost::uint64_t agentStreamNumber(const AgentId& id, boost::uint64_t round){
+  boost::uint64_t number = hashStreamKey(0, round);
+  number = hashStreamKey(number, boost::uint32_t(id.id()));
+  number = hashStreamKey(number, boost::uint32_t(id.startingRank()));
+  return hashStreamKey(number, boost::uint32_t(id.agentType()));
+}
+
+RandomStream& agentRandom(){
+  if(currentScope == 0) throw Repast_Error_60();
+  return currentScope->stream;
+}
+
+int parallelAgentIndex(){
+  return (currentScope == 0 ? -1 : currentScope->index);
+}
+
+int parallelThreadNumber(){
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+ParallelAgentScope::ParallelAgentScope(int agentIndex, boost::uint64_t key, boost::uint64_t streamNumber) :
+    stream(key, streamNumber), index(agentIndex), previous(currentScope){
+  currentScope = this;
+}
+
+ParallelAgentScope::~ParallelAgentScope(){
+  currentScope = previous;
+}
+
+}
@@ -0,0 +1,229 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  ParallelAgents.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef PARALLELAGENTS_H_
+#define PARALLELAGENTS_H_
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+
+#include "AgentId.h"
+#include "Point.h"
+#include "Random.h"
+#include "RandomStream.h"
+#include "initialize_threads.h"
+
+namespace repast {
+
+/**
+ * Gets the number of the random stream of the specified agent in the
+ * specified round. The stream depends only on the agent's id, starting
+ * rank and type, so it does not change when the agent moves between
+ * processes.
+ */
+boost::uint64_t agentStreamNumber(const AgentId& id, boost::uint64_t round);
+
+/**
+ * Gets the random stream of the agent that the calling thread is currently
+ * processing in forEachAgentInParallel (or in Context::parallelForEach or
+ * relogo's AgentSet::askParallel and applyParallel, which use it). Each
+ * agent has its own stream for each parallel loop, determined by the seed
+ * of the Random singleton, the agent's id and the number of the loop, so
+ * the draws do not depend on the thread count or on which thread processes
+ * the agent.
+ *
+ * Throws Repast_Error_60 if called outside such a loop.
+ */
+RandomStream& agentRandom();
+
+/**
+ * Gets the position, within the agents of the current parallel loop, of
+ * the agent that the calling thread is processing, or -1 if it is not in
+ * a parallel loop.
+ */
+int parallelAgentIndex();
+
+/**
+ * Gets the number of the calling thread within the current parallel loop
+ * (0 outside a loop).
+ */
+int parallelThreadNumber();
+
+/**
+ * Marks the calling thread as processing the agent at the specified
+ * position of a parallel loop, with the specified stream, for the
+ * lifetime of this object.
+ */
+class ParallelAgentScope {
+
+private:
+  RandomStream stream;
+  int index;
+  ParallelAgentScope* previous;
+
+  friend RandomStream& agentRandom();
+  friend int parallelAgentIndex();
+
+public:
+  ParallelAgentScope(int agentIndex, boost::uint64_t key, boost::uint64_t streamNumber);
+  ~ParallelAgentScope();
+};
+
+/**
+ * Calls func on each of the agents, split across the process's threads
+ * (see setThreadCount). Inside func, agentRandom() gives the agent's own
+ * random stream and DeferredMoves collects grid moves.
+ *
+ * func is called concurrently for different agents, so it must not modify
+ * state shared between agents: it may read the context and projections
+ * but must not add, remove or move agents directly, nor draw from the
+ * Random singleton or its named generators. Exceptions must not escape func.
+ *
+ * @param agents the agents to process
+ * @param func an object that implements operator()(T* agent)
+ *
+ * @tparam T the agent type; T must implement getId()
+ */
+template<typename T, typename Functor>
+void forEachAgentInParallel(const std::vector<T*>& agents, Functor& func){
+  Random* random = Random::instance();
+  boost::uint64_t key   = random->seed();
+  boost::uint64_t round = random->nextStreamRound();
+  int count   = agents.size();
+  int threads = getThreadCount();
+#pragma omp parallel for schedule(dynamic, 64) num_threads(threads) if(threads > 1)
+  for(int i = 0; i < count; i++){
+    T* agent = agents[i];
+    ParallelAgentScope scope(i, key, agentStreamNumber(agent->getId(), round));
+    func(agent);
+  }
+}
+
+/**
+ * Collects grid moves made inside a parallel agent loop and applies them
+ * afterwards. Each thread records its moves in its own buffer, so recording
+ * needs no locking; apply() then performs them in the order of the agents
+ * in the loop (and, for each agent, in the order it made them), so the
+ * outcome (e.g. which of two agents gets a cell in a single occupancy grid)
+ * does not depend on the thread count.
+ *
+ * @tparam GPType the coordinate type of the grid
+ */
+template<typename GPType>
+class DeferredMoves {
+
+private:
+  struct Move {
+    int index;
+    AgentId id;
+    std::vector<GPType> location;
+
+    Move(int agentIndex, const AgentId& agentId, const std::vector<GPType>& newLocation) :
+      index(agentIndex), id(agentId), location(newLocation){}
+
+    bool operator<(const Move& other) const { return index < other.index; }
+  };
+
+  std::vector<std::vector<Move> > threadMoves;
+
+public:
+  /**
+   * Creates an empty set of moves with a buffer for each of the process's
+   * threads. The thread count must not be raised between creating (or
+   * applying) the moves and the parallel loop that records them.
+   */
+  DeferredMoves() : threadMoves(getThreadCount()){ }
+
+  /**
+   * Records a move of the specified agent. Must be called from inside a
+   * parallel agent loop, or outside any parallel region.
+   */
+  void moveTo(const AgentId& id, const std::vector<GPType>& newLocation){
+    std::vector<Move>& moves = threadMoves.at(parallelThreadNumber());
+    moves.push_back(Move(parallelAgentIndex(), id, newLocation));
+  }
+
+  /**
+   * Records a move of the specified agent. Must be called from inside a
+   * parallel agent loop, or outside any parallel region.
+   */
+  void moveTo(const AgentId& id, const Point<GPType>& newLocation){
+    moveTo(id, newLocation.coords());
+  }
+
+  /**
+   * Gets the number of recorded moves.
+   */
+  size_t size() const {
+    size_t total = 0;
+    for(size_t i = 0; i < threadMoves.size(); i++) total += threadMoves[i].size();
+    return total;
+  }
+
+  /**
+   * Performs the recorded moves on the grid, in agent order, and clears them.
+   *
+   * @param grid a grid that implements moveTo(const AgentId&, const std::vector<GPType>&)
+   *
+   * @return the number of moves that succeeded
+   */
+  template<typename Grid>
+  int apply(Grid& grid){
+    std::vector<Move> moves;
+    moves.reserve(size());
+    for(size_t i = 0; i < threadMoves.size(); i++){
+      moves.insert(moves.end(), threadMoves[i].begin(), threadMoves[i].end());
+      threadMoves[i].clear();
+    }
+    // Each agent's moves come from one thread in program order, so a stable sort keeps them in order
+    std::stable_sort(moves.begin(), moves.end());
+    int moved = 0;
+    for(size_t i = 0; i < moves.size(); i++){
+      if(grid.moveTo(moves[i].id, moves[i].location)) moved++;
+    }
+    threadMoves.resize(std::max(threadMoves.size(), (size_t)getThreadCount()));
+    return moved;
+  }
+};
+
+}
+
+#endif /* PARALLELAGENTS_H_ */
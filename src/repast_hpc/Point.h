@@ -42,6 +42,7 @@
 #define POINT_H_
 
 #include <vector>
+#include <array>
 #include <stdexcept>
 #include <iostream>
 #include <algorithm>
@@ -55,27 +56,243 @@
 namespace repast {
 
 /**
- * A N-dimensional Point representation.
+ * A N-dimensional Point representation. Point<T> (N == 0) holds any number
+ * of dimensions; Point<T, N> holds exactly N and never allocates.
  */
-template<typename T>
+template<typename T, std::size_t N = 0>
 class Point;
 
+/**
+ * Computes the hash of a range of point coordinates. Fixed and dynamic
+ * points with the same coordinates hash to the same value.
+ */
+template<typename T, typename Iterator>
+std::size_t hashCoordinates(Iterator begin, Iterator end) {
+	std::size_t hash = 17;
+	boost::hash<T> hasher;
+	for (; begin != end; ++begin) {
+		hash = 37 * hash + hasher(*begin);
+	}
+	return hash;
+}
+
 /**
  * Class that allows retrieval of hash value for Point objects.
  */
-template<typename T>
+template<typename T, std::size_t N = 0>
 struct HashGridPoint {
+	std::size_t operator()(const Point<T, N>& pt) const {
+		return hashCoordinates<T>(pt.begin(), pt.end());
+	}
+};
+
+template<typename T>
+struct HashGridPoint<T, 0> {
 	std::size_t operator()(const Point<T>& pt) const {
 		return pt.hash;
 	}
 };
 
+/**
+ * Compares the coordinates of points regardless of whether they are
+ * fixed or dynamic, so that a hash map keyed on one kind can be searched
+ * with the other.
+ */
+struct EqualGridPoint {
+	template<typename T, std::size_t N, std::size_t M>
+	bool operator()(const Point<T, N>& one, const Point<T, M>& two) const {
+		return one.dimensionCount() == two.dimensionCount() && std::equal(one.begin(), one.end(), two.begin());
+	}
+
+	template<typename T, std::size_t N>
+	bool operator()(const Point<T, N>& one, const std::vector<T>& two) const {
+		return one.dimensionCount() == two.size() && std::equal(one.begin(), one.end(), two.begin());
+	}
+};
+
 template<typename T>
 bool operator==(const Point<T> &one, const Point<T> &two);
 
 template<typename T>
 std::ostream& operator<<(std::ostream& os, const Point<T>& pt);
 
+/**
+ * Fixed dimension point for addressing matrix locations. The coordinates
+ * are held in place, so creating, copying and hashing one never touches
+ * the allocator; grids keyed on Point<T, N> move agents and answer
+ * neighborhood queries without allocating.
+ *
+ * @param T a numeric type. In repast and relogo these are limited to int
+ * and double.
+ * @param N the number of dimensions
+ */
+template<typename T, std::size_t N>
+class Point {
+
+private:
+	std::array<T, N> point;
+
+	friend class boost::serialization::access;
+
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int version) {
+		for (std::size_t i = 0; i < N; i++) {
+			ar & point[i];
+		}
+	}
+
+	template<typename Iterator>
+	void assign(Iterator begin, std::size_t size) {
+		if (size != N) throw Repast_Error_62(size, N); // Coordinates do not have N dimensions
+		std::copy(begin, begin + N, point.begin());
+	}
+
+public:
+
+	typedef typename std::array<T, N>::const_iterator const_iterator;
+
+	/**
+	 * Creates a point at the origin.
+	 */
+	Point() {
+		point.fill(0);
+	}
+
+	/**
+	 * Creates a one dimensional point with the specified value.
+	 */
+	explicit Point(T x) {
+		static_assert(N == 1, "Point(x) requires a one dimensional point");
+		point[0] = x;
+	}
+
+	/**
+	 * Creates a two dimensional point with the specified values.
+	 */
+	Point(T x, T y) {
+		static_assert(N == 2, "Point(x, y) requires a two dimensional point");
+		point[0] = x;
+		point[1] = y;
+	}
+
+	/**
+	 * Creates a three dimensional point with the specified values.
+	 */
+	Point(T x, T y, T z) {
+		static_assert(N == 3, "Point(x, y, z) requires a three dimensional point");
+		point[0] = x;
+		point[1] = y;
+		point[2] = z;
+	}
+
+	/**
+	 * Creates a point from the specified coordinates.
+	 *
+	 * @throws Repast_Error_62 if there are not exactly N coordinates
+	 */
+	explicit Point(const std::vector<T>& coordinates) {
+		assign(coordinates.begin(), coordinates.size());
+	}
+
+	/**
+	 * Creates a point with the same coordinates as the specified point.
+	 *
+	 * @throws Repast_Error_62 if pt does not have exactly N dimensions
+	 */
+	template<std::size_t M>
+	explicit Point(const Point<T, M>& pt) {
+		assign(pt.begin(), pt.dimensionCount());
+	}
+
+	T getX() const {
+		return point[0];
+	}
+
+	T getY() const {
+		static_assert(N >= 2, "getY() requires at least two dimensions");
+		return point[1];
+	}
+
+	T getZ() const {
+		static_assert(N >= 3, "getZ() requires at least three dimensions");
+		return point[2];
+	}
+
+	T getCoordinate(int coordIndex) const {
+		return point.at(coordIndex);
+	}
+
+	/**
+	 * Adds the specified point to this point. This point contains
+	 * the result.
+	 */
+	void add(const Point<T, N>& pt) {
+		for (std::size_t i = 0; i < N; i++) {
+			point[i] += pt.point[i];
+		}
+	}
+
+	std::size_t dimensionCount() const {
+		return N;
+	}
+
+	const T& operator[](std::size_t index) const {
+		return point[index];
+	}
+
+	/**
+	 * Gets the coordinate value at the specified index. Unlike the
+	 * dynamic Point there is no cached hash, so the coordinate may be
+	 * assigned through the returned reference.
+	 */
+	T& operator[](std::size_t index) {
+		return point[index];
+	}
+
+	const std::array<T, N>& coords() const {
+		return point;
+	}
+
+	const_iterator begin() const {
+		return point.begin();
+	}
+
+	const_iterator end() const {
+		return point.end();
+	}
+
+	/**
+	 * Copies the point into the specified vector, resizing it to N
+	 * if necessary.
+	 */
+	void copy(std::vector<T>& out) const {
+		out.assign(point.begin(), point.end());
+	}
+
+	friend bool operator==(const Point<T, N>& one, const Point<T, N>& two) {
+		return one.point == two.point;
+	}
+
+	friend bool operator!=(const Point<T, N>& one, const Point<T, N>& two) {
+		return !(one.point == two.point);
+	}
+
+	friend bool operator<(const Point<T, N>& one, const Point<T, N>& two) {
+		return one.point < two.point;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const Point<T, N>& pt) {
+		os << "Point[";
+		for (std::size_t i = 0; i < N; i++) {
+			if (i > 0)
+				os << ", ";
+			os << pt.point[i];
+		}
+		os << "]";
+		return os;
+	}
+};
+
 /**
  * N dimensional point for addressing matrix locations.
  *
@@ -83,7 +300,7 @@ std::ostream& operator<<(std::ostream& os, const Point<T>& pt);
  * and double.
  */
 template<typename T>
-class Point {
+class Point<T, 0> {
 
 private:
 	friend bool operator==<> (const Point<T> &one, const Point<T> &two);
@@ -139,6 +356,32 @@ public:
 	 */
 	Point(std::vector<T> coordinates);
 
+	/**
+	 * Creates a point with the same coordinates as the specified fixed
+	 * dimension point.
+	 *
+	 * @param pt the point to copy
+	 */
+	template<std::size_t N>
+	Point(const Point<T, N>& pt) :
+		point(pt.begin(), pt.end()) {
+		calcHash();
+	}
+
+	/**
+	 * Assigns the coordinates of the specified fixed dimension point to
+	 * this point, reusing the existing coordinate storage when the
+	 * dimensions agree.
+	 *
+	 * @param pt the point to copy
+	 */
+	template<std::size_t N>
+	Point& operator=(const Point<T, N>& pt) {
+		point.assign(pt.begin(), pt.end());
+		calcHash();
+		return *this;
+	}
+
 	/**
 	 * Gets the x coordinate of the point.
 	 *
@@ -294,11 +537,7 @@ Point<T>::Point(std::vector<T> coordinates) :
 
 template<typename T>
 void Point<T>::calcHash() {
-	hash = 17;
-	boost::hash<T> hasher;
-	for (size_t i = 0; i < point.size(); i++) {
-		hash = 37 * hash + hasher(point[i]);
-	}
+	hash = hashCoordinates<T>(point.begin(), point.end());
 }
 
 template<typename T>
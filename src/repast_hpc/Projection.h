@@ -45,6 +45,8 @@
 #include <string>
 #include <set>
 #include <map>
+#include <vector>
+#include <cstring>
 #include <boost/shared_ptr.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/serialization/serialization.hpp>
@@ -52,6 +54,7 @@
 #include <boost/serialization/set.hpp>
 
 #include "AgentId.h"
+#include "AgentIdSet.h"
 
 namespace repast {
 
@@ -115,6 +118,37 @@ public:
 
 };
 
+/**
+ * Appends a flat byte image of a SpecializedProjectionInfoPacket to the buffer:
+ * the four components of the agent id, the number of data values, then the
+ * values themselves. Only valid for trivially copyable Datum types.
+ */
+template<typename Datum>
+void packProjectionInfoPacket(const SpecializedProjectionInfoPacket<Datum>& packet, std::vector<char>& buffer){
+  int header[5] = { packet.id.id(), packet.id.startingRank(), packet.id.agentType(),
+      packet.id.currentRank(), (int)packet.data.size() };
+  size_t offset = buffer.size();
+  buffer.resize(offset + sizeof(header) + packet.data.size() * sizeof(Datum));
+  memcpy(&buffer[offset], header, sizeof(header));
+  if(!packet.data.empty()) memcpy(&buffer[offset + sizeof(header)], &packet.data[0], packet.data.size() * sizeof(Datum));
+}
+
+/**
+ * Reads a packet written by packProjectionInfoPacket, advancing position past it.
+ */
+template<typename Datum>
+SpecializedProjectionInfoPacket<Datum>* unpackProjectionInfoPacket(const char*& position){
+  int header[5];
+  memcpy(header, position, sizeof(header));
+  position += sizeof(header);
+  SpecializedProjectionInfoPacket<Datum>* packet = new SpecializedProjectionInfoPacket<Datum>(
+      AgentId(header[0], header[1], header[2], header[3]));
+  packet->data.resize(header[4]);
+  if(header[4] > 0) memcpy(&packet->data[0], position, header[4] * sizeof(Datum));
+  position += header[4] * sizeof(Datum);
+  return packet;
+}
+
 template<typename T>
 class Context;
 
@@ -141,6 +175,26 @@ protected:
 
   virtual void updateProjectionInfo(ProjectionInfoPacket* pip, Context<T>* context) = 0;
 
+  /**
+   * Should return true if this projection can write the packets returned by
+   * getProjectionInfo as flat bytes, using packProjectionInfo and
+   * unpackProjectionInfo. Spaces can; graphs, whose edge content is serialized,
+   * cannot.
+   */
+  virtual bool projectionInfoIsPackable(){ return false; }
+
+  /**
+   * Appends a flat byte image of the packet to the buffer. Only called if
+   * projectionInfoIsPackable returns true.
+   */
+  virtual void packProjectionInfo(ProjectionInfoPacket* pip, std::vector<char>& buffer){ }
+
+  /**
+   * Reads a packet written by packProjectionInfo, advancing position past it.
+   * Only called if projectionInfoIsPackable returns true.
+   */
+  virtual ProjectionInfoPacket* unpackProjectionInfo(const char*& position){ return 0; }
+
 public:
 
   enum RADIUS{ PRIMARY, SECONDARY };
@@ -270,7 +324,7 @@ public:
    * 'contract' to the specified radius. Generally spaces do not require any agents, but graphs
    * do- generally the non-local ends to master copies of edges.
    */
-  virtual void getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsRequired, RADIUS radius = PRIMARY) = 0;
+  virtual void getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsRequired, RADIUS radius = PRIMARY) = 0;
 
   /**
    * Given a set of agents, gets the agents that this projection implementation must 'push' to
@@ -278,7 +332,7 @@ public:
    * must push local agents that are vertices to master edges where the other vertex is non-
    * local. The results are returned per-process in the agentsToPush map.
    */
-  virtual void getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush) = 0;
+  virtual void getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush) = 0;
 
   // Note: Virtual because some child classes may be able to short-circuit this (like Graphs)
   /**
@@ -294,7 +348,7 @@ public:
    */
   void updateProjectionInfo(std::vector<ProjectionInfoPacket*>& pips, Context<T>* context);
 
-  virtual void cleanProjectionInfo(std::set<AgentId>& agentsToKeep) = 0;
+  virtual void cleanProjectionInfo(AgentIdSet& agentsToKeep) = 0;
 
   virtual void balance(){};
 
@@ -39,8 +39,10 @@
  */
 
 #include "Random.h"
+#include "AgentId.h"
 
 #include <ctime>
+#include <cstring>
 
 namespace repast {
 
@@ -49,11 +51,57 @@ using namespace boost;
 
 Random* Random::instance_ = nullptr;
 
-Random::Random(uint32_t seed) : rng(seed), uniGen(_RealUniformGenerator(rng, boost::uniform_real<>(0, 1))) {
+namespace {
 
+// Separate the stream numbers of agents from those of processes
+const boost::uint64_t AGENT_STREAMS   = 1;
+const boost::uint64_t PROCESS_STREAMS = 2;
+
+boost::uint64_t tickBits(double tick) {
+    boost::uint64_t bits;
+    memcpy(&bits, &tick, sizeof(bits));
+    return bits;
+}
+
+boost::uint32_t seedOf(const RandomEngine& generator) {
+    if (generator.type() == RandomEngine::PHILOX) return (boost::uint32_t) generator.philox().key();
+    boost::mt19937 first(generator.mt19937());
+    return first();
+}
+
+}
+
+RandomEngine::RandomEngine(uint32_t seed, Type type) : _type(type), _mt(seed), _philox(seed) {
+
+}
+
+RandomEngine::RandomEngine(const boost::mt19937& generator) : _type(MT19937), _mt(generator) {
+
+}
+
+RandomEngine::RandomEngine(const Philox4x32& generator) : _type(PHILOX), _philox(generator) {
+
+}
+
+ostream& operator<<(ostream& os, const RandomEngine& engine) {
+    if (engine._type == RandomEngine::PHILOX) os << engine._philox;
+    else os << engine._mt;
+    return os;
 }
 
-Random::Random(boost::mt19937 generator) : rng(generator), uniGen(_RealUniformGenerator(rng, boost::uniform_real<>(0, 1))) {
+istream& operator>>(istream& is, RandomEngine& engine) {
+    if (engine._type == RandomEngine::PHILOX) is >> engine._philox;
+    else is >> engine._mt;
+    return is;
+}
+
+Random::Random(uint32_t seed, RandomEngine::Type type) : rng(seed, type),
+    uniGen(_RealUniformGenerator(rng, boost::uniform_real<>(0, 1))), _seed(seed), streamRound(0) {
+
+}
+
+Random::Random(const RandomEngine& generator) : rng(generator),
+    uniGen(_RealUniformGenerator(rng, boost::uniform_real<>(0, 1))), _seed(seedOf(generator)), streamRound(0) {
 
 }
 
@@ -71,6 +119,17 @@ void Random::initialize(uint32_t seed) {
 }
 
 void Random::initialize(boost::mt19937 generator) {
+    initialize(RandomEngine(generator));
+}
+
+void Random::initialize(uint32_t seed, RandomEngine::Type type) {
+    if (instance_) {
+        delete instance_;
+    }
+    instance_ = new Random(seed, type);
+}
+
+void Random::initialize(const RandomEngine& generator) {
     if (instance_) {
         delete instance_;
     }
@@ -149,6 +208,20 @@ LogNormalGenerator Random::createLogNormalGenerator(double mean, double sigma) {
  }
  */
 
+RandomStream Random::createStream(const AgentId& id, double tick, boost::uint64_t stream) const {
+    boost::uint64_t number = hashStreamKey(AGENT_STREAMS, (boost::uint32_t) id.id());
+    number = hashStreamKey(number, (boost::uint32_t) id.startingRank());
+    number = hashStreamKey(number, (boost::uint32_t) id.agentType());
+    number = hashStreamKey(number, tickBits(tick));
+    return RandomStream(_seed, hashStreamKey(number, stream));
+}
+
+RandomStream Random::createStream(int rank, double tick, boost::uint64_t stream) const {
+    boost::uint64_t number = hashStreamKey(PROCESS_STREAMS, (boost::uint32_t) rank);
+    number = hashStreamKey(number, tickBits(tick));
+    return RandomStream(_seed, hashStreamKey(number, stream));
+}
+
 void Random::putGenerator(const string& id, NumberGenerator* generator) {
     generators.insert( make_pair(id, generator));
 }
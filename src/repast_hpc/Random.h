@@ -45,6 +45,7 @@
 #include <set>
 #include <map>
 #include <string>
+#include <iostream>
 
 
 #include <boost/random/variate_generator.hpp>
@@ -59,19 +60,115 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/cstdint.hpp>
 
+#include "RandomStream.h"
+
 
 namespace repast {
 
-typedef boost::variate_generator<boost::mt19937&, boost::uniform_real<> > _RealUniformGenerator;
-typedef boost::variate_generator<boost::mt19937&, boost::uniform_int<> > _IntUniformGenerator;
+class AgentId;
+
+/**
+ * The engine behind the Random singleton: either a boost::mt19937 (the
+ * default) or a counter-based Philox4x32. Both produce 32-bit values, so
+ * the distributions give the same kinds of results with either.
+ *
+ * With mt19937, reproducibility depends on every draw being made in the
+ * same order. With Philox the process's own sequence is still ordered,
+ * but agents can draw independently from streams created with
+ * Random::createStream, which are keyed by seed, agent, tick and stream
+ * number rather than by call order.
+ */
+class RandomEngine {
+
+public:
+    enum Type {
+        MT19937, PHILOX
+    };
+
+    typedef boost::uint32_t result_type;
+
+    /**
+     * Creates an engine of the specified type seeded with the specified seed.
+     */
+    explicit RandomEngine(boost::uint32_t seed, Type type = MT19937);
+
+    /**
+     * Creates an mt19937 engine with the state of the specified generator.
+     */
+    explicit RandomEngine(const boost::mt19937& generator);
+
+    /**
+     * Creates a Philox engine with the state of the specified generator.
+     */
+    explicit RandomEngine(const Philox4x32& generator);
+
+    result_type operator()() {
+        return (_type == PHILOX ? _philox() : _mt());
+    }
 
-typedef boost::variate_generator<boost::mt19937&, boost::triangle_distribution<> > _TriangleGenerator;
-typedef boost::variate_generator<boost::mt19937&, boost::cauchy_distribution<> > _CauchyGenerator;
-typedef boost::variate_generator<boost::mt19937&, boost::exponential_distribution<> > _ExponentialGenerator;
-typedef boost::variate_generator<boost::mt19937&, boost::geometric_distribution<boost::uniform_real<> > >
+    static result_type min() {
+        return 0;
+    }
+
+    static result_type max() {
+        return 0xFFFFFFFF;
+    }
+
+    Type type() const {
+        return _type;
+    }
+
+    /**
+     * Gets the mt19937 engine; meaningful only if the type is MT19937.
+     */
+    boost::mt19937& mt19937() {
+        return _mt;
+    }
+
+    const boost::mt19937& mt19937() const {
+        return _mt;
+    }
+
+    /**
+     * Gets the Philox engine; meaningful only if the type is PHILOX.
+     */
+    Philox4x32& philox() {
+        return _philox;
+    }
+
+    const Philox4x32& philox() const {
+        return _philox;
+    }
+
+    /**
+     * Writes the state of the engine of this engine's type.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const RandomEngine& engine);
+
+    /**
+     * Reads the state of the engine of this engine's type.
+     */
+    friend std::istream& operator>>(std::istream& is, RandomEngine& engine);
+
+private:
+    Type _type;
+    boost::mt19937 _mt;
+    Philox4x32 _philox;
+};
+
+std::ostream& operator<<(std::ostream& os, const RandomEngine& engine);
+std::istream& operator>>(std::istream& is, RandomEngine& engine);
+
+typedef boost::variate_generator<RandomEngine&, boost::uniform_real<> > _RealUniformGenerator;
+typedef boost::variate_generator<RandomEngine&, boost::uniform_int<> > _IntUniformGenerator;
+
+typedef boost::variate_generator<RandomEngine&, boost::triangle_distribution<> > _TriangleGenerator;
+typedef boost::variate_generator<RandomEngine&, boost::cauchy_distribution<> > _CauchyGenerator;
+typedef boost::variate_generator<RandomEngine&, boost::exponential_distribution<> > _ExponentialGenerator;
+typedef boost::variate_generator<RandomEngine&, boost::geometric_distribution<boost::uniform_real<> > >
         _GeometricGenerator;
-typedef boost::variate_generator<boost::mt19937&, boost::normal_distribution<> > _NormalGenerator;
-typedef boost::variate_generator<boost::mt19937&, boost::lognormal_distribution<> > _LogNormalGenerator;
+typedef boost::variate_generator<RandomEngine&, boost::normal_distribution<> > _NormalGenerator;
+typedef boost::variate_generator<RandomEngine&, boost::lognormal_distribution<> > _LogNormalGenerator;
 
 /**
  * Number generator interface.
@@ -130,14 +227,16 @@ class Random {
 private:
     static Random* instance_;
 
-    boost::mt19937 rng;
+    RandomEngine rng;
     _RealUniformGenerator uniGen;
+    boost::uint32_t _seed;
+    boost::uint64_t streamRound;
 
     std::map<std::string, NumberGenerator*> generators;
 
 protected:
-    Random(boost::uint32_t seed);
-    Random(boost::mt19937 generator);
+    Random(boost::uint32_t seed, RandomEngine::Type type = RandomEngine::MT19937);
+    Random(const RandomEngine& generator);
 
 public:
 
@@ -155,6 +254,22 @@ public:
      */
     static void initialize(boost::mt19937 generator);
 
+    /**
+     * Initialize the Random singleton with the specified seed and engine type.
+     *
+     * @param seed the seed to initialize the random number generator with.
+     * @param type the type of engine
+     */
+    static void initialize(boost::uint32_t seed, RandomEngine::Type type);
+
+    /**
+     * Initialize the Random singleton with the state of the specified engine
+     * (e.g. one read back from a stream).
+     *
+     * @param generator the random number engine
+     */
+    static void initialize(const RandomEngine& generator);
+
     /**
      * Gets the singleton instance of this Random.
      */
@@ -183,19 +298,57 @@ public:
      *
      * @return he random number engine from which the distributions are created.
      */
-    boost::mt19937& engine() {
+    RandomEngine& engine() {
         return rng;
     }
 
     /**
-     * Gets the current seed.
+     * Gets the seed this Random was initialized with. If it was initialized
+     * with a generator, this is the first number that generator produces.
      *
-     * @return the current seed.
+     * @return the seed this Random was initialized with.
+     */
+    boost::uint32_t seed() const {
+        return _seed;
+    }
+
+    /**
+     * Starts a new round of per-agent random streams (see forEachAgentInParallel)
+     * and returns its number. Rounds are numbered from 0 after each
+     * initialization, so a model that runs the same sequence of parallel
+     * loops draws the same streams.
      *
-    boost::uint32_t seed() {
-        return seed;
+     * @return the number of the new round
+     */
+    boost::uint64_t nextStreamRound() {
+        return streamRound++;
     }
-    */
+
+    /**
+     * Creates the counter-based stream of the specified agent for the
+     * specified tick and stream number. The stream is determined by the seed
+     * and these values alone, whatever the engine type and whatever has been
+     * drawn before, so agents can draw from their streams in any order or
+     * concurrently. It does not depend on the agent's current rank, so an
+     * agent keeps its streams when it moves between processes.
+     *
+     * @param id the agent's id
+     * @param tick the current tick
+     * @param stream the number of the stream, to give an agent several
+     * independent streams in one tick
+     */
+    RandomStream createStream(const AgentId& id, double tick, boost::uint64_t stream = 0) const;
+
+    /**
+     * Creates the counter-based stream of the specified process for the
+     * specified tick and stream number. The stream is determined by the seed
+     * and these values alone.
+     *
+     * @param rank the process's rank
+     * @param tick the current tick
+     * @param stream the number of the stream
+     */
+    RandomStream createStream(int rank, double tick, boost::uint64_t stream = 0) const;
 
     /**
      * Gets the next double in the range [0, 1).
@@ -0,0 +1,141 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  RandomStream.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "RandomStream.h"
+
+namespace repast {
+
+namespace {
+
+const boost::uint32_t PHILOX_M0 = 0xD2511F53;
+const boost::uint32_t PHILOX_M1 = 0xCD9E8D57;
+const boost::uint32_t PHILOX_W0 = 0x9E3779B9;
+const boost::uint32_t PHILOX_W1 = 0xBB67AE85;
+const int PHILOX_ROUNDS = 10;
+
+inline void mulhilo(boost::uint32_t a, boost::uint32_t b, boost::uint32_t& hi, boost::uint32_t& lo){
+  boost::uint64_t product = boost::uint64_t(a) * b;
+  hi = boost::uint32_t(product >> 32);
+  lo = boost::uint32_t(product);
+}
+
+}
+
+boost::uint64_t hashStreamKey(boost::uint64_t hash, boost::uint64_t value){
+  value = hash ^ (value + 0x9E3779B97F4A7C15ULL);
+  value ^= value >> 30;
+  value *= 0xBF58476D1CE4E5B9ULL;
+  value ^= value >> 27;
+  value *= 0x94D049BB133111EBULL;
+  value ^= value >> 31;
+  return value;
+}
+
+Philox4x32::Philox4x32(boost::uint64_t key, boost::uint64_t stream){
+  seed(key, stream);
+}
+
+void Philox4x32::seed(boost::uint64_t key, boost::uint64_t stream){
+  _key[0] = boost::uint32_t(key);
+  _key[1] = boost::uint32_t(key >> 32);
+  _stream = stream;
+  _block  = 0;
+  used    = 4;
+}
+
+void Philox4x32::block(const boost::uint32_t counter[4], const boost::uint32_t key[2], boost::uint32_t out[4]){
+  boost::uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+  boost::uint32_t k0 = key[0], k1 = key[1];
+  for(int round = 0; round < PHILOX_ROUNDS; round++){
+    if(round > 0){
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+    }
+    boost::uint32_t hi0, lo0, hi1, lo1;
+    mulhilo(PHILOX_M0, c0, hi0, lo0);
+    mulhilo(PHILOX_M1, c2, hi1, lo1);
+    c0 = hi1 ^ c1 ^ k0;
+    c1 = lo1;
+    c2 = hi0 ^ c3 ^ k1;
+    c3 = lo0;
+  }
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+void Philox4x32::nextBlock(){
+  boost::uint32_t counter[4] = { boost::uint32_t(_block), boost::uint32_t(_block >> 32),
+                                 boost::uint32_t(_stream), boost::uint32_t(_stream >> 32) };
+  block(counter, _key, output);
+  _block++;
+  used = 0;
+}
+
+void Philox4x32::discard(boost::uint64_t count){
+  boost::uint64_t target = position() + count;
+  _block = target / 4;
+  used   = 4;
+  int offset = target % 4;
+  if(offset > 0){
+    nextBlock();
+    used = offset;
+  }
+}
+
+bool Philox4x32::operator==(const Philox4x32& other) const {
+  return key() == other.key() && _stream == other._stream && position() == other.position();
+}
+
+std::ostream& operator<<(std::ostream& os, const Philox4x32& engine){
+  os << engine.key() << " " << engine.stream() << " " << engine.position();
+  return os;
+}
+
+std::istream& operator>>(std::istream& is, Philox4x32& engine){
+  boost::uint64_t key, stream, position;
+  if(is >> key >> stream >> position){
+    engine.seed(key, stream);
+    engine.discard(position);
+  }
+  return is;
+}
+
+}
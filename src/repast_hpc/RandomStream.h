@@ -0,0 +1,203 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  RandomStream.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef RANDOMSTREAM_H_
+#define RANDOMSTREAM_H_
+
+#include <iostream>
+
+#include <boost/cstdint.hpp>
+#include <boost/random/uniform_int.hpp>
+
+namespace repast {
+
+/**
+ * Counter-based random number engine (Philox4x32-10; Salmon et al., "Parallel
+ * Random Numbers: As Easy as 1, 2, 3", SC11). Each block of four outputs is
+ * a bijective hash of a 128-bit counter under a 64-bit key, so any position
+ * of any stream can be computed directly and independently of every other
+ * stream. The counter holds the 64-bit stream number and the 64-bit block
+ * index within the stream.
+ *
+ * Satisfies the boost/std uniform random number generator requirements, so
+ * it can be used with the boost random distributions.
+ */
+class Philox4x32 {
+
+private:
+  boost::uint32_t _key[2];
+  boost::uint64_t _stream;
+  boost::uint64_t _block;
+  boost::uint32_t output[4];
+  int used;
+
+  void nextBlock();
+
+public:
+  typedef boost::uint32_t result_type;
+
+  /**
+   * Creates an engine at the start of the specified stream.
+   *
+   * @param key the key (seed) of the engine
+   * @param stream the number of the stream
+   */
+  Philox4x32(boost::uint64_t key = 0, boost::uint64_t stream = 0);
+
+  /**
+   * Moves this engine to the start of the specified stream.
+   *
+   * @param key the key (seed) of the engine
+   * @param stream the number of the stream
+   */
+  void seed(boost::uint64_t key, boost::uint64_t stream = 0);
+
+  /**
+   * Gets the next number in the stream.
+   */
+  result_type operator()(){
+    if(used == 4) nextBlock();
+    return output[used++];
+  }
+
+  /**
+   * Skips the specified count of numbers in O(1).
+   */
+  void discard(boost::uint64_t count);
+
+  /**
+   * Gets the key of this engine.
+   */
+  boost::uint64_t key() const {
+    return (boost::uint64_t(_key[1]) << 32) | _key[0];
+  }
+
+  /**
+   * Gets the stream number of this engine.
+   */
+  boost::uint64_t stream() const {
+    return _stream;
+  }
+
+  /**
+   * Gets the count of numbers drawn from the stream so far.
+   */
+  boost::uint64_t position() const {
+    return _block * 4 - (4 - used);
+  }
+
+  static result_type min(){ return 0; }
+  static result_type max(){ return 0xFFFFFFFF; }
+
+  /**
+   * Computes one block of the Philox4x32-10 function: encrypts the
+   * 128-bit counter under the 64-bit key.
+   */
+  static void block(const boost::uint32_t counter[4], const boost::uint32_t key[2], boost::uint32_t out[4]);
+
+  bool operator==(const Philox4x32& other) const;
+  bool operator!=(const Philox4x32& other) const { return !(*this == other); }
+
+  /**
+   * Writes the key, stream and position of the engine.
+   */
+  friend std::ostream& operator<<(std::ostream& os, const Philox4x32& engine);
+
+  /**
+   * Reads the key, stream and position of the engine.
+   */
+  friend std::istream& operator>>(std::istream& is, Philox4x32& engine);
+};
+
+std::ostream& operator<<(std::ostream& os, const Philox4x32& engine);
+std::istream& operator>>(std::istream& is, Philox4x32& engine);
+
+/**
+ * Mixes value into a stream number hash (SplitMix64 finalizer), for
+ * deriving stream numbers from several identifying values.
+ */
+boost::uint64_t hashStreamKey(boost::uint64_t hash, boost::uint64_t value);
+
+/**
+ * A random stream backed by a Philox4x32 engine, with the draws agents
+ * usually need. Streams are cheap to create (a few words of state, no
+ * warm-up), so one can be made per agent per step.
+ */
+class RandomStream {
+
+private:
+  Philox4x32 _engine;
+
+public:
+  /**
+   * Creates the specified stream.
+   *
+   * @param key the key (seed) of the stream
+   * @param stream the number of the stream
+   */
+  RandomStream(boost::uint64_t key = 0, boost::uint64_t stream = 0) : _engine(key, stream){}
+
+  /**
+   * Gets the next double in the range [0, 1), with 53 random bits.
+   */
+  double nextDouble(){
+    boost::uint32_t high = _engine() >> 5;
+    boost::uint32_t low  = _engine() >> 6;
+    return (high * 67108864.0 + low) * (1.0 / 9007199254740992.0);
+  }
+
+  /**
+   * Gets the next int in the range [from, to].
+   */
+  int nextInt(int from, int to){
+    boost::uniform_int<> dist(from, to);
+    return dist(_engine);
+  }
+
+  /**
+   * Gets the engine, for use with the boost random distributions.
+   */
+  Philox4x32& engine(){
+    return _engine;
+  }
+};
+
+}
+
+#endif /* RANDOMSTREAM_H_ */
@@ -879,6 +879,71 @@ public:
       RESOLUTION    "Modify the incorrect line in the properties file, or alter the code to provide a communicator for initializeSeed"
 END_ERR
 
+/* Error 58 */
+class Repast_Error_58: public std::invalid_argument{
+public:
+  Repast_Error_58(size_t received, size_t local): INVALID_ARG(ERROR_NUMBER 58)
+      THROWN_BY     "Context<T>::setProjectionInfo(std::vector<std::vector<repast::ProjectionInfoPacket*> >& projInfo)"
+      REASON        "Projection information for " + make_str(received) + " projections received, but this context has only " + make_str(local)
+      EXPLANATION   "Projection information is exchanged between processes indexed by the order in which projections were added to the context; every process must add the same projections in the same order."
+      CAUSE         "Projections were added to the context on the sending process that have not been added on this process."
+      RESOLUTION    "Add the same projections, in the same order, to the context on all processes."
+END_ERR
+
+/* Error 59 */
+class Repast_Error_59: public std::invalid_argument{
+public:
+  Repast_Error_59(std::string value): INVALID_ARG(ERROR_NUMBER 59)
+      THROWN_BY     "initializeThreads(Properties& props)"
+      REASON        "Invalid thread count '" + value + "'"
+      EXPLANATION   "The thread.count property must be a positive number of threads per process or 'AUTO'."
+      CAUSE         "Generally this is a problem in the properties file or in the command line arguments."
+      RESOLUTION    "Alter the properties specification to give a positive integer or 'AUTO'."
+END_ERR
+
+/* Error 60 */
+class Repast_Error_60: public std::domain_error{
+public:
+  Repast_Error_60(): DOMAIN_ERR(ERROR_NUMBER 60)
+      THROWN_BY     "agentRandom()"
+      REASON        "No agent is being processed by a parallel agent loop on this thread"
+      EXPLANATION   "Per-agent random streams exist only inside forEachAgentInParallel, Context::parallelForEach and relogo's AgentSet::askParallel and applyParallel."
+      CAUSE         "Agent code that uses agentRandom() was called from a serial loop."
+      RESOLUTION    "Call the code through one of the parallel agent loops, or use the Random singleton outside them."
+END_ERR
+
+/* Error 61 */
+class Repast_Error_61: public std::invalid_argument{
+public:
+  Repast_Error_61(std::string value): INVALID_ARG(ERROR_NUMBER 61)
+      THROWN_BY     "initializeSeed(Properties& props, boost::mpi::communicator* comm)"
+      REASON        "Unrecognized random engine '" + value + "'"
+      EXPLANATION   "The random.engine property must be 'mt19937' or 'philox'."
+      CAUSE         "Generally this is a problem in the properties file or in the command line arguments."
+      RESOLUTION    "Alter the properties specification to name one of the supported engines."
+END_ERR
+
+/* Error 62 */
+class Repast_Error_62: public std::invalid_argument{
+public:
+  Repast_Error_62(int size, int dims): INVALID_ARG(ERROR_NUMBER 62)
+      THROWN_BY     "Point<T, N>::Point(const std::vector<T>& coordinates)"
+      REASON        "Coordinates have " + VAL(size) + " dimensions, but the point has " + VAL(dims)
+      EXPLANATION   "A fixed dimension point can only be created from coordinates with exactly as many dimensions as the point type."
+      CAUSE         "Generally a Point<T, N> was used with a grid or space whose dimension count is not N."
+      RESOLUTION    "Use a point type whose dimension count matches the grid, or the dynamically sized Point<T>."
+END_ERR
+
+class Repast_Error_63: public std::invalid_argument{
+public:
+  Repast_Error_63(int pointDims, int spaceDims): INVALID_ARG(ERROR_NUMBER 63)
+      THROWN_BY     "SharedContinuousSpace::queryBox, queryRadius or kNearest"
+      REASON        "The query point has " + VAL(pointDims) + " dimensions while the space has " + VAL(spaceDims)
+      EXPLANATION   "The points a continuous space is queried with must have as many dimensions as the space."
+      CAUSE         "Generally the query was built for a space of a different dimension count."
+      RESOLUTION    "Query with points whose dimension count matches the space."
+END_ERR
+
 /* TEMPLATE
 class Repast_Error_: public std::invalid_argument{
 public:
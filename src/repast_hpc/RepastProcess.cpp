@@ -68,7 +68,7 @@ RepastProcess* RepastProcess::_instance = 0;
 RepastProcess::RepastProcess(boost::mpi::communicator* comm) : world(comm), runner(new ScheduleRunner(world)),
 		rank_(world->rank()), worldSize_(world->size()),
 		procsToSendProjInfoTo(NULL), procsToRecvProjInfoFrom(NULL), procsToSendAgentStatusInfoTo(NULL),
-		procsToRecvAgentStatusInfoFrom(NULL) {
+		procsToRecvAgentStatusInfoFrom(NULL), sparseRequestRound(0), srEngine(SRManager::ALLTOALL) {
 
 	//world = comm;
 	//runner = new ScheduleRunner(world);
@@ -172,7 +172,7 @@ void RepastProcess::initiateAgentRequest(AgentRequest& request
 #ifdef SHARE_AGENTS_BY_SET
 		, std::string setName, AGENT_IMPORTER_EXPORTER_TYPE setType
 #endif
-		) {
+		, AGENT_REQUEST_EXCHANGE exchange) {
 
 	// Record and process the outgoing request for agents from other processes
 #ifndef SHARE_AGENTS_BY_SET
@@ -181,6 +181,24 @@ void RepastProcess::initiateAgentRequest(AgentRequest& request
 	importer_exporter->registerOutgoingRequests(request, setName, setType);
 #endif
 
+	vector<AgentRequest> reqsRecd;
+	if (exchange == SPARSE)
+		exchangeAgentRequestsSparse(request, reqsRecd);
+	else
+		exchangeAgentRequestsAlltoall(request, reqsRecd);
+
+	// Set up export of agents requested by other processes
+#ifndef SHARE_AGENTS_BY_SET
+	importer_exporter->registerIncomingRequests(reqsRecd);
+#else
+	importer_exporter->registerIncomingRequests(reqsRecd, setName);
+#endif
+
+}
+
+void RepastProcess::exchangeAgentRequestsAlltoall(const AgentRequest& request,
+		vector<AgentRequest>& reqsRecd) {
+
 	int* countsOfRequests = new int[worldSize_];
 	for (int i = 0; i < worldSize_; ++i)
 		countsOfRequests[i] = 0; // OOPS! This was not included in version 1.0.1 final
@@ -258,8 +276,6 @@ void RepastProcess::initiateAgentRequest(AgentRequest& request
 	delete[] data; // Done with this...
 
 	// Now re-package the received data as the vector<AgentRequest> that is needed
-
-	vector<AgentRequest> reqsRecd;
 	for (int i = 0; i < worldSize_; i++) {
 		if (i != rank_) { // This isn't necessary as long as a process doesn't request agents from itself (!); this acts as an error trap if this happens
 			int index = i * dataElementSize;
@@ -289,14 +305,97 @@ void RepastProcess::initiateAgentRequest(AgentRequest& request
 
 	delete[] countsOfRequests;
 	delete[] rec;
+}
 
-	// Set up export of agents requested by other processes
-#ifndef SHARE_AGENTS_BY_SET
-	importer_exporter->registerIncomingRequests(reqsRecd);
-#else
-	importer_exporter->registerIncomingRequests(reqsRecd, setName);
-#endif
+void RepastProcess::exchangeAgentRequestsSparse(const AgentRequest& request,
+		vector<AgentRequest>& reqsRecd) {
+
+	const vector<AgentId>& requestedAgents = request.requestedAgents();
+	const vector<AgentId>& cancellations = request.cancellations();
+
+	// Pack one variable-length message per targeted process. The first int is the number
+	// of requests; it is followed by the requests and then the cancellations, each as
+	// (id, starting rank, type) triples.
+	map<int, vector<int> > payloads;
+	for (vector<AgentId>::const_iterator agentId = requestedAgents.begin(), agentIdEnd = requestedAgents.end();
+			agentId != agentIdEnd; ++agentId) {
+		vector<int>& payload = payloads[agentId->currentRank()];
+		if (payload.empty()) payload.push_back(0);
+		payload[0]++;
+		payload.push_back(agentId->id());
+		payload.push_back(agentId->startingRank());
+		payload.push_back(agentId->agentType());
+	}
+	for (vector<AgentId>::const_iterator agentId = cancellations.begin(), agentIdEnd = cancellations.end();
+			agentId != agentIdEnd; ++agentId) {
+		vector<int>& payload = payloads[agentId->currentRank()];
+		if (payload.empty()) payload.push_back(0);
+		payload.push_back(agentId->id());
+		payload.push_back(agentId->startingRank());
+		payload.push_back(agentId->agentType());
+	}
+	payloads.erase(rank_); // A process never requests agents from itself
+
+	// Alternate tags between consecutive calls: a process that has left the previous
+	// exchange may already be sending while a neighbor is still probing for that one
+	int tag = (sparseRequestRound++ % 2 == 0 ? AGENT_REQUEST_SPARSE_EVEN : AGENT_REQUEST_SPARSE_ODD);
+
+	// Non-blocking consensus (NBX): synchronous sends complete only once matched, so
+	// when all of this process's sends are done it can enter a non-blocking barrier;
+	// when the barrier completes every message sent to this process has been received.
+	vector<MPI_Request> sends;
+	sends.reserve(payloads.size());
+	for (map<int, vector<int> >::iterator iter = payloads.begin(), iterEnd = payloads.end(); iter != iterEnd; ++iter) {
+		MPI_Request req;
+		MPI_Issend(&iter->second[0], iter->second.size(), MPI_INT, iter->first, tag, *world, &req);
+		sends.push_back(req);
+	}
+
+	MPI_Request barrier;
+	bool barrierActive = false;
+	vector<int> rec;
+	while (true) {
+		int flag;
+		MPI_Status status;
+		MPI_Iprobe(MPI_ANY_SOURCE, tag, *world, &flag, &status);
+		if (flag) {
+			int count;
+			MPI_Get_count(&status, MPI_INT, &count);
+			rec.resize(count);
+			MPI_Recv(&rec[0], count, MPI_INT, status.MPI_SOURCE, tag, *world, MPI_STATUS_IGNORE);
+
+			AgentRequest req(status.MPI_SOURCE, rank_);
+			int numRequests = rec[0];
+			for (int i = 0, index = 1; index < count; i++, index += 3) {
+				AgentId id(rec[index], rec[index + 1], rec[index + 2]);
+				id.currentRank(rank_);
+				if (i < numRequests)
+					req.addRequest(id);
+				else
+					req.addCancellation(id);
+			}
+			reqsRecd.push_back(req);
+		}
+
+		if (barrierActive) {
+			int done;
+			MPI_Test(&barrier, &done, MPI_STATUS_IGNORE);
+			if (done) break;
+		} else {
+			int sent = 1;
+			if (!sends.empty()) MPI_Testall(sends.size(), &sends[0], &sent, MPI_STATUSES_IGNORE);
+			if (sent) {
+				MPI_Ibarrier(*world, &barrier);
+				barrierActive = true;
+			}
+		}
+	}
+}
 
+void RepastProcess::waitForContentSends(vector<MPI_Request>& requests) {
+	if (!requests.empty())
+		MPI_Waitall(requests.size(), &requests[0], MPI_STATUSES_IGNORE);
+	requests.clear();
 }
 
 RepastProcess::~RepastProcess() {
@@ -45,7 +45,9 @@
 #include <map>
 #include <set>
 #include <list>
+#include <cstring>
 #include <iostream>
+#include <type_traits>
 
 #include <boost/mpi/communicator.hpp>
 #include <boost/lexical_cast.hpp>
@@ -54,6 +56,8 @@
 #include <boost/ptr_container/ptr_list.hpp>
 #include <boost/serialization/utility.hpp>
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 
 #include "Schedule.h"
 #include "AgentId.h"
@@ -83,6 +87,63 @@
 
 namespace repast {
 
+/**
+ * Trait that opts an agent Content type into the contiguous exchange path.
+ * When it is true, vectors of Content are sent between processes as raw bytes
+ * instead of through boost::serialization. Specialize it with
+ * REPAST_CONTENT_IS_TRIVIALLY_COPYABLE, at namespace scope, for Content that is trivially
+ * copyable; the Content type must have the same layout on every process. It must
+ * still be serializable, as the serialized exchange paths are compiled for it too.
+ */
+template<typename Content>
+struct is_trivially_packable: public boost::false_type {
+};
+
+#define REPAST_CONTENT_IS_TRIVIALLY_COPYABLE(T) \
+	namespace repast { \
+	template<> \
+	struct is_trivially_packable<T>: public boost::true_type { \
+		static_assert(std::is_trivially_copyable<T>::value, #T " is not trivially copyable"); \
+	}; \
+	}
+
+typedef std::vector<std::vector<ProjectionInfoPacket*> > ProjectionInfoByOrdinal;
+
+/**
+ * Writes trivially packable agent Content and its projection information as a
+ * single flat byte image: the number of Content items, the Content bytes, then
+ * the projection information as written by Context::packProjectionInfo. Requires
+ * that every projection in the context can pack its projection information.
+ */
+template<typename T, typename Content>
+void packAgentData(Context<T>& context, std::vector<Content>& content,
+		ProjectionInfoByOrdinal& projectionInfo, std::vector<char>& buffer) {
+	int count = content.size();
+	size_t offset = buffer.size();
+	buffer.resize(offset + sizeof(int) + count * sizeof(Content));
+	memcpy(&buffer[offset], &count, sizeof(int));
+	if (count > 0)
+		memcpy(&buffer[offset + sizeof(int)], &content[0], count * sizeof(Content));
+	context.packProjectionInfo(projectionInfo, buffer);
+}
+
+/**
+ * Reads agent Content and projection information written by packAgentData.
+ */
+template<typename T, typename Content>
+void unpackAgentData(Context<T>& context, const std::vector<char>& buffer,
+		std::vector<Content>& content, ProjectionInfoByOrdinal& projectionInfo) {
+	const char* position = &buffer[0];
+	int count;
+	memcpy(&count, position, sizeof(int));
+	position += sizeof(int);
+	content.resize(count);
+	if (count > 0)
+		memcpy(&content[0], position, count * sizeof(Content));
+	position += count * sizeof(Content);
+	context.unpackProjectionInfo(position, projectionInfo);
+}
+
 /**
  * Contains information sent as agents are exchanged, either in response to
  * requests or agent movement. Contains both agent raw information
@@ -94,6 +155,12 @@ namespace repast {
  * in the user code). Some code must be written to track these down and delete,
  * and it is manifestly easier to provide that code in the Packet itself
  * than to rewrite where needed, inspecting the Packet for the locations
+ *
+ * Projection information is indexed by the ordinal of the projection in
+ * the context. If the Content is trivially packable it is not serialized
+ * with the packet; it is sent separately as raw bytes. If, in addition, every
+ * projection can pack its projection information (see packAgentData), the
+ * packet is not serialized at all: its contents travel as one raw message.
  */
 template<typename Content>
 class Request_Packet {
@@ -102,14 +169,14 @@ class Request_Packet {
 
 public:
 	std::vector<Content>* agentContentPtr;
-	std::map<std::string, std::vector<ProjectionInfoPacket*> >* projectionInfoPtr;
+	ProjectionInfoByOrdinal* projectionInfoPtr;
 
 	Request_Packet() :
 			agentContentPtr(0), projectionInfoPtr(0) {
 	}
 
 	Request_Packet(std::vector<Content>* agentContent,
-			std::map<std::string, std::vector<ProjectionInfoPacket*> >* projectionInfo) :
+			ProjectionInfoByOrdinal* projectionInfo) :
 			agentContentPtr(agentContent), projectionInfoPtr(projectionInfo) {
 	}
 
@@ -118,11 +185,10 @@ public:
 		agentContentPtr = 0;
 
 		if (projectionInfoPtr != 0) {
-			for (std::map<std::string, std::vector<ProjectionInfoPacket*> >::iterator
-					iter = projectionInfoPtr->begin(), iterEnd =
-							projectionInfoPtr->end(); iter != iterEnd; ++iter) {
+			for (ProjectionInfoByOrdinal::iterator iter = projectionInfoPtr->begin(),
+					iterEnd = projectionInfoPtr->end(); iter != iterEnd; ++iter) {
 				for (std::vector<ProjectionInfoPacket*>::iterator PIPIter =
-						iter->second.begin(), PIPIterEnd = iter->second.end();
+						iter->begin(), PIPIterEnd = iter->end();
 						PIPIter != PIPIterEnd; ++PIPIter) {
 					delete *PIPIter;
 				}
@@ -135,7 +201,8 @@ public:
 
 	template<class Archive>
 	void serialize(Archive& ar, const unsigned int version) {
-		ar & agentContentPtr;
+		if (!is_trivially_packable<Content>::value)
+			ar & agentContentPtr;
 		ar & projectionInfoPtr;
 	}
 
@@ -149,6 +216,11 @@ public:
  * of projection contracts and the new existence of the agents being moved
  * to that process).
  *
+ * As with Request_Packet, projection information is indexed by projection
+ * ordinal and trivially packable Content is sent separately as raw bytes,
+ * together with the projection information if every projection can pack it;
+ * the secondary ids and exporter information are always serialized.
+ *
  * Note the unusual requirement of the deletion of exporter information.
  */
 template<typename Content>
@@ -158,20 +230,22 @@ class SyncStatus_Packet {
 
 public:
 	std::vector<Content>* agentContentPtr;
-	std::map<std::string, std::vector<ProjectionInfoPacket*> >* projectionInfoPtr;
+	ProjectionInfoByOrdinal* projectionInfoPtr;
 	std::set<AgentId>* secondaryIdsPtr;
 	AgentExporterInfo* exporterInfoPtr;
+	bool packedProjectionInfo; // true if projection info travels with the raw Content bytes
 
-	SyncStatus_Packet() :
+	SyncStatus_Packet(bool packed = false) :
 			agentContentPtr(0), projectionInfoPtr(0), secondaryIdsPtr(0), exporterInfoPtr(
-					0) {
+					0), packedProjectionInfo(packed) {
 	}
 
 	SyncStatus_Packet(std::vector<Content>* agentContent,
-			std::map<std::string, std::vector<ProjectionInfoPacket*> >* projectionInfo,
-			std::set<AgentId>* secondaryIds, AgentExporterInfo* exporterInfo) :
+			ProjectionInfoByOrdinal* projectionInfo,
+			std::set<AgentId>* secondaryIds, AgentExporterInfo* exporterInfo,
+			bool packed = false) :
 			agentContentPtr(agentContent), projectionInfoPtr(projectionInfo), secondaryIdsPtr(
-					secondaryIds), exporterInfoPtr(exporterInfo) {
+					secondaryIds), exporterInfoPtr(exporterInfo), packedProjectionInfo(packed) {
 	}
 
 	~SyncStatus_Packet() {
@@ -179,11 +253,10 @@ public:
 		agentContentPtr = 0;
 
 		if (projectionInfoPtr != 0) {
-			for (std::map<std::string, std::vector<ProjectionInfoPacket*> >::iterator
-					iter = projectionInfoPtr->begin(), iterEnd =
-							projectionInfoPtr->end(); iter != iterEnd; ++iter) {
+			for (ProjectionInfoByOrdinal::iterator iter = projectionInfoPtr->begin(),
+					iterEnd = projectionInfoPtr->end(); iter != iterEnd; ++iter) {
 				for (std::vector<ProjectionInfoPacket*>::iterator PIPIter =
-						iter->second.begin(), PIPIterEnd = iter->second.end();
+						iter->begin(), PIPIterEnd = iter->end();
 						PIPIter != PIPIterEnd; ++PIPIter) {
 					delete *PIPIter;
 				}
@@ -216,8 +289,10 @@ public:
 
 	template<class Archive>
 	void serialize(Archive& ar, const unsigned int version) {
-		ar & agentContentPtr;
-		ar & projectionInfoPtr;
+		if (!is_trivially_packable<Content>::value)
+			ar & agentContentPtr;
+		if (!packedProjectionInfo)
+			ar & projectionInfoPtr;
 		ar & secondaryIdsPtr;
 		ar & exporterInfoPtr;
 	}
@@ -236,6 +311,18 @@ public:
 		POLL, USE_CURRENT, USE_LAST_OR_POLL, USE_LAST_OR_USE_CURRENT
 	};
 
+	/**
+	 * How agent requests are routed to the processes that own the requested agents.
+	 * ALLTOALL uses a single MPI_Alltoall padded to the largest request count on any
+	 * process; SPARSE sends variable-length messages only to the processes actually
+	 * targeted, using a non-blocking consensus (synchronous sends plus MPI_Ibarrier).
+	 * SPARSE is preferable when each process requests agents from few others. All
+	 * processes must use the same mode for a given call.
+	 */
+	enum AGENT_REQUEST_EXCHANGE {
+		ALLTOALL, SPARSE
+	};
+
 private:
 
 	typedef boost::unordered_set<AgentId, HashId> MovedAgentSetType;
@@ -263,13 +350,18 @@ private:
 
 	// called by request agents function to initiate the request
 #ifndef SHARE_AGENTS_BY_SET
-	void initiateAgentRequest(AgentRequest& requests);
+	void initiateAgentRequest(AgentRequest& requests, AGENT_REQUEST_EXCHANGE exchange = ALLTOALL);
 #else
 	void initiateAgentRequest(AgentRequest& requests, std::string setName =
 	DEFAULT_AGENT_REQUEST_SET, AGENT_IMPORTER_EXPORTER_TYPE setType =
-	DEFAULT_ENUM_SYMBOL);
+	DEFAULT_ENUM_SYMBOL, AGENT_REQUEST_EXCHANGE exchange = ALLTOALL);
 #endif
 
+	// route this process's requests to their owners and collect the requests
+	// other processes have made of this one
+	void exchangeAgentRequestsAlltoall(const AgentRequest& request, std::vector<AgentRequest>& reqsRecd);
+	void exchangeAgentRequestsSparse(const AgentRequest& request, std::vector<AgentRequest>& reqsRecd);
+
 	std::vector<int>* procsToSendProjInfoTo;
 	std::vector<int>* procsToRecvProjInfoFrom;
 
@@ -278,6 +370,29 @@ private:
 
 	std::vector<CartesianTopology*> cartesianTopologies;
 
+	// number of sparse request exchanges so far; used to alternate message tags
+	int sparseRequestRound;
+
+	// engine used by SRManager for POLL partner discovery
+	SRManager::Engine srEngine;
+
+	// bookkeeping for synchronizeAgentStatus and synchronizeProjectionInfo,
+	// cleared rather than recreated each call so their storage is reused
+	AgentIdSet syncAgentsToKeep;
+	AgentIdSet syncAgentsToDrop;
+	std::map<int, AgentIdSet> syncAgentsToPush;
+
+	// contiguous exchange of trivially packable Content: each vector is sent as a
+	// single raw byte message, and the receiver probes for its size
+	template<typename Content>
+	void isendContent(int dest, int tag, std::vector<Content>& content,
+			std::vector<MPI_Request>& requests);
+
+	template<typename Content>
+	void recvContent(int source, int tag, std::vector<Content>& content);
+
+	void waitForContentSends(std::vector<MPI_Request>& requests);
+
 protected:
 	RepastProcess(boost::mpi::communicator* comm = 0);
 
@@ -406,6 +521,19 @@ public:
 		return world;
 	}
 
+	/**
+	 * Sets the engine used to discover which processes will send to this one
+	 * when agent status or projection information is synchronized using the
+	 * POLL exchange pattern. The default, SRManager::ALLTOALL, costs O(P) per
+	 * call; the sparse engines scale with the number of actual partners. All
+	 * processes must use the same engine.
+	 *
+	 * @param engine the engine to use
+	 */
+	void setSourceRetrievalEngine(SRManager::Engine engine) {
+		srEngine = engine;
+	}
+
 
 	CartesianTopology* getCartesianTopology(std::vector<int> processesPerDim, bool spaceIsPeriodic);
 
@@ -438,7 +566,8 @@ public:
 	// about what information is updated.)
 
 	/**
-	 * Request agents from other processes.
+	 * Request agents from other processes. The optional exchange argument selects
+	 * how the requests are routed to the owning processes (see AGENT_REQUEST_EXCHANGE).
 	 */
 	template<typename T, typename Content, typename Provider, typename Updater,
 			typename AgentCreator>
@@ -448,7 +577,24 @@ public:
 			, std::string setName = DEFAULT_AGENT_REQUEST_SET,
 			AGENT_IMPORTER_EXPORTER_TYPE setType = DEFAULT_ENUM_SYMBOL
 #endif
-			);
+			, AGENT_REQUEST_EXCHANGE exchange = ALLTOALL);
+
+#ifdef SHARE_AGENTS_BY_SET
+	/**
+	 * Request agents from other processes into the default agent request set,
+	 * routing the requests as specified by exchange. Equivalent to calling
+	 * requestAgents with DEFAULT_AGENT_REQUEST_SET and DEFAULT_ENUM_SYMBOL, so
+	 * that the exchange can be chosen without spelling out the set arguments.
+	 */
+	template<typename T, typename Content, typename Provider, typename Updater,
+			typename AgentCreator>
+	void requestAgents(SharedContext<T>& context, AgentRequest& request,
+			Provider& provider, Updater& updater, AgentCreator& creator,
+			AGENT_REQUEST_EXCHANGE exchange) {
+		requestAgents<T, Content, Provider, Updater, AgentCreator>(context, request,
+				provider, updater, creator, DEFAULT_AGENT_REQUEST_SET, DEFAULT_ENUM_SYMBOL, exchange);
+	}
+#endif
 
 	/**
 	 * Synchronizes the state values of shared agents. Does not change the Projection information
@@ -507,6 +653,8 @@ public:
  * @param request the AgentRequest containing the ids of the requested agents
  * @param provider provides Content for a given an AgentRequest
  * @param creator creates agents of type T given Content.
+ * @param exchange how the requests are routed to the processes that own the
+ * requested agents; SPARSE avoids the padded all-to-all when few processes are targeted
  *
  *
  * @tparam T the type of the agents in the context
@@ -527,13 +675,13 @@ void RepastProcess::requestAgents(SharedContext<T>& context,
 #ifdef SHARE_AGENTS_BY_SET
 		, std::string setName, AGENT_IMPORTER_EXPORTER_TYPE setType
 #endif
-		) {
+		, AGENT_REQUEST_EXCHANGE exchange) {
 
 	// Initiate the new requests
 #ifdef SHARE_AGENTS_BY_SET
-	initiateAgentRequest(request, setName, setType);
+	initiateAgentRequest(request, setName, setType, exchange);
 #else
-	initiateAgentRequest(request);
+	initiateAgentRequest(request, exchange);
 #endif
 
 	// Establish which processes are sending to/receiving from this one
@@ -549,6 +697,10 @@ void RepastProcess::requestAgents(SharedContext<T>& context,
 
 	// Construct MPI requests (Receives and Sends)
 	std::vector<boost::mpi::request> requests; // MPI Requests (receives and sends)
+	std::vector<MPI_Request> contentRequests; // Raw Content sends, if Content is trivially packable
+	bool packContent = is_trivially_packable<Content>::value;
+	bool packAll = packContent && context.projectionInfoIsPackable(); // One raw message per partner
+	std::list<std::vector<char> > packedData; // Raw sends, if packAll
 
 	// Construct Receives
 	std::vector<Request_Packet<Content>*> toReceive;
@@ -557,7 +709,8 @@ void RepastProcess::requestAgents(SharedContext<T>& context,
 			iter != exporters.end(); ++iter) {
 		Request_Packet<Content>* packet;
 		toReceive.push_back(packet = new Request_Packet<Content>());
-		requests.push_back(world->irecv(*iter, 23, *packet));
+		if (!packAll)
+			requests.push_back(world->irecv(*iter, 23, *packet));
 	}
 
 	// Construct Sends
@@ -572,19 +725,41 @@ void RepastProcess::requestAgents(SharedContext<T>& context,
 		provider.provideContent(iter->second, *content);
 
 		// Projection Info
-		std::map<std::string, std::vector<ProjectionInfoPacket*> >* projInfo =
-				new std::map<std::string,
-						std::vector<repast::ProjectionInfoPacket*> >;
+		ProjectionInfoByOrdinal* projInfo = new ProjectionInfoByOrdinal;
 		context.getProjectionInfo(iter->second, *projInfo);
 
 		Request_Packet<Content>* packet;
 		toSend->push_back(
 				packet = new Request_Packet<Content>(content, projInfo));
-		requests.push_back(world->isend(iter->first, 23, *packet));
+		if (packAll) {
+			packedData.push_back(std::vector<char>());
+			packAgentData(context, *content, *projInfo, packedData.back());
+			isendContent(iter->first, AGENT_REQUEST_CONTENT, packedData.back(), contentRequests);
+		} else {
+			requests.push_back(world->isend(iter->first, 23, *packet));
+			if (packContent)
+				isendContent(iter->first, AGENT_REQUEST_CONTENT, *content, contentRequests);
+		}
 	}
 
 	// Wait until all sends/receives complete
 	boost::mpi::wait_all(requests.begin(), requests.end());
+	if (packContent) {
+		std::set<int>::const_iterator source = exporters.begin();
+		std::vector<char> received;
+		for (size_t i = 0; i < toReceive.size(); ++i, ++source) {
+			toReceive[i]->agentContentPtr = new std::vector<Content>;
+			if (packAll) {
+				toReceive[i]->projectionInfoPtr = new ProjectionInfoByOrdinal;
+				recvContent(*source, AGENT_REQUEST_CONTENT, received);
+				unpackAgentData(context, received, *(toReceive[i]->agentContentPtr),
+						*(toReceive[i]->projectionInfoPtr));
+			} else {
+				recvContent(*source, AGENT_REQUEST_CONTENT, *(toReceive[i]->agentContentPtr));
+			}
+		}
+		waitForContentSends(contentRequests);
+	}
 
 	// Clear sent data
 	delete toSend;
@@ -628,6 +803,33 @@ void RepastProcess::synchronizeAgentStates(Provider& provider, Updater& updater
 	const std::map<int, AgentRequest>& agentsToExport = importer_exporter->getAgentsToExport();
 #endif
 
+	if (is_trivially_packable<Content>::value) {
+		// Contiguous path: one raw byte message per partner, no serialization
+		std::vector<MPI_Request> contentRequests;
+		boost::ptr_list<std::vector<Content> > toSend;
+		for (std::map<int, AgentRequest>::const_iterator iter =
+				agentsToExport.begin(), iterEnd = agentsToExport.end();
+				iter != iterEnd; ++iter) {
+			std::vector<Content>* content = new std::vector<Content>;
+			toSend.push_back(content);
+			provider.provideContent(iter->second, *content);
+			isendContent(iter->first, AGENT_SYNC_STATE_CONTENT, *content, contentRequests);
+		}
+
+		std::vector<Content> content;
+		for (std::set<int>::const_iterator iter = processesToReceiveFrom.begin(),
+				iterEnd = processesToReceiveFrom.end(); iter != iterEnd; ++iter) {
+			recvContent(*iter, AGENT_SYNC_STATE_CONTENT, content);
+			for (typename std::vector<Content>::const_iterator agentIter =
+					content.begin(), agentIterEnd = content.end();
+					agentIter != agentIterEnd; ++agentIter) {
+				updater.updateAgent(*agentIter);
+			}
+		}
+		waitForContentSends(contentRequests);
+		return;
+	}
+
 	// Construct MPI Requests (sends and receives)
 	std::vector<boost::mpi::request> requests;
 
@@ -685,7 +887,8 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 		) {
 
 	// Generate sets of agents to delete or not delete
-	std::set<AgentId> agentsToKeep;
+	AgentIdSet& agentsToKeep = syncAgentsToKeep;
+	agentsToKeep.clear();
 
 	bool agentsMayBeKept =
 #ifdef SHARE_AGENTS_BY_SET
@@ -708,11 +911,12 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 #endif
 
 	// Determine all agents that the context doesn't need and are not on 'Keep' list, adding those that it needs to the 'Keep' list
-	std::set<AgentId> agentsToDrop;
+	AgentIdSet& agentsToDrop = syncAgentsToDrop;
+	agentsToDrop.clear();
 	context.getNonlocalAgentsToDrop(agentsToKeep, agentsToDrop);
 
 	// Drop all of the agents that can be dropped
-	std::set<AgentId>::iterator dropIter = agentsToDrop.begin(), dropIterEnd =
+	AgentIdSet::const_iterator dropIter = agentsToDrop.begin(), dropIterEnd =
 			agentsToDrop.end();
 	while (dropIter != dropIterEnd) {
 		context.removeAgent(*dropIter);
@@ -726,7 +930,7 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 	// Initiate Agent Request (so that I/E will have agents needed by other processes)
 	if (agentsMayBeKept) {
 		AgentRequest req;
-		for (std::set<AgentId>::iterator iter = agentsToKeep.begin(), iterEnd =
+		for (AgentIdSet::const_iterator iter = agentsToKeep.begin(), iterEnd =
 				agentsToKeep.end(); iter != iterEnd; ++iter) {
 			req.addRequest(*iter); // TO DO: Better optimized constructor
 		}
@@ -734,16 +938,21 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 	}
 
 	// Determine which agents will be 'pushed' to other processes
-	std::map<int, std::set<AgentId> > agentsToPush;
+	// (the per-process sets are kept between calls, so some may be empty)
+	std::map<int, AgentIdSet>& agentsToPush = syncAgentsToPush;
+	for (std::map<int, AgentIdSet>::iterator iter = agentsToPush.begin(),
+			iterEnd = agentsToPush.end(); iter != iterEnd; ++iter)
+		iter->second.clear();
 	context.getAgentsToPushToOtherProcesses(agentsToPush);
 
 	// Add these to I/E as exports
 	std::vector<AgentRequest> requests;
-	for (std::map<int, std::set<AgentId> >::iterator iter =
-			agentsToPush.begin(), iterEnd = agentsToPush.end(); iter != iterEnd;
-			++iter) {
+	for (std::map<int, AgentIdSet>::iterator iter = agentsToPush.begin(),
+			iterEnd = agentsToPush.end(); iter != iterEnd; ++iter) {
+		if (iter->second.empty())
+			continue;
 		AgentRequest req(iter->first);
-		for (std::set<AgentId>::iterator i = iter->second.begin(), iEnd =
+		for (AgentIdSet::const_iterator i = iter->second.begin(), iEnd =
 				iter->second.end(); i != iEnd; i++)
 			req.addRequest(*i);
 		requests.push_back(req);
@@ -793,7 +1002,7 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 				iter != iterEnd; ++iter) {
 			psToSendTo.push_back(iter->first);
 		}
-		SRManager manager(world);
+		SRManager manager(world, srEngine);
 		manager.retrieveSources(psToSendTo, psToReceiveFrom,
 				AGENT_MOVED_SENDERS);
 	} else {
@@ -817,6 +1026,10 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 
 	// Construct MPI requests (Receives and Sends)
 	std::vector<boost::mpi::request> MPIRequests; // MPI Requests (receives and sends)
+	std::vector<MPI_Request> contentRequests; // Raw Content sends, if Content is trivially packable
+	bool packContent = is_trivially_packable<Content>::value;
+	bool packAll = packContent && context.projectionInfoIsPackable(); // One raw message per partner
+	std::list<std::vector<char> > packedData; // Raw sends, if packAll
 
 	// Construct Receives
 	std::map<int, Request_Packet<Content>*> toReceive;
@@ -825,7 +1038,8 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 			psToReceiveFrom.end(); iter != iterEnd; ++iter) {
 		Request_Packet<Content>* packet;
 		toReceive[*iter] = (packet = new Request_Packet<Content>());
-		MPIRequests.push_back(world->irecv(*iter, 23, *packet));
+		if (!packAll)
+			MPIRequests.push_back(world->irecv(*iter, 23, *packet));
 	}
 
 	// Construct Sends
@@ -843,19 +1057,42 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 		provider.provideContent(rq, *contentVector);
 
 		// Projection Info
-		std::map<std::string, std::vector<ProjectionInfoPacket*> >* projInfo =
-				new std::map<std::string,
-						std::vector<repast::ProjectionInfoPacket*> >;
+		ProjectionInfoByOrdinal* projInfo = new ProjectionInfoByOrdinal;
 		context.getProjectionInfo(rq, *projInfo, true, 0, dest); // Will collect the edges but not the secondary IDs
 
 		Request_Packet<Content>* packet;
 		toSend->push_back(
 				packet = new Request_Packet<Content>(contentVector, projInfo));
-		MPIRequests.push_back(world->isend(dest, 23, *packet));
+		if (packAll) {
+			packedData.push_back(std::vector<char>());
+			packAgentData(context, *contentVector, *projInfo, packedData.back());
+			isendContent(dest, AGENT_SYNC_PROJ_CONTENT, packedData.back(), contentRequests);
+		} else {
+			MPIRequests.push_back(world->isend(dest, 23, *packet));
+			if (packContent)
+				isendContent(dest, AGENT_SYNC_PROJ_CONTENT, *contentVector, contentRequests);
+		}
 	}
 
 	// Wait until all sends/receives complete
 	boost::mpi::wait_all(MPIRequests.begin(), MPIRequests.end());
+	if (packContent) {
+		std::vector<char> received;
+		for (typename std::map<int, Request_Packet<Content>*>::iterator iter =
+				toReceive.begin(), iterEnd = toReceive.end(); iter != iterEnd;
+				++iter) {
+			iter->second->agentContentPtr = new std::vector<Content>;
+			if (packAll) {
+				iter->second->projectionInfoPtr = new ProjectionInfoByOrdinal;
+				recvContent(iter->first, AGENT_SYNC_PROJ_CONTENT, received);
+				unpackAgentData(context, received, *(iter->second->agentContentPtr),
+						*(iter->second->projectionInfoPtr));
+			} else {
+				recvContent(iter->first, AGENT_SYNC_PROJ_CONTENT, *(iter->second->agentContentPtr));
+			}
+		}
+		waitForContentSends(contentRequests);
+	}
 
 	// Clear sent data
 	delete toSend;
@@ -937,7 +1174,8 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 	// Step 2: Send moving agents' information to new home processes
 	//
 	// First, some basic data structures must be created for some bookkeeping we will need later
-	std::set<AgentId> agentsToDrop; // A list of agents that will be removed from this process
+	AgentIdSet& agentsToDrop = syncAgentsToDrop; // A list of agents that will be removed from this process
+	agentsToDrop.clear();
 	std::set<int> psMovedTo; // A list of the processes that will be receiving moving agents
 	std::map<int, AgentRequest> agentRequests; // A map of these receiving processes and a list of the IDs of the agents going to them
 
@@ -1003,7 +1241,7 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 				iter != iterEnd; ++iter) {
 			psToSendTo.push_back(iter->first);
 		}
-		SRManager manager(world);
+		SRManager manager(world, srEngine);
 		manager.retrieveSources(psToSendTo, psToReceiveFrom,
 				AGENT_MOVED_SENDERS);
 	} else {
@@ -1030,6 +1268,10 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 
 	// Create MPI Sends and Receives
 	std::vector<boost::mpi::request> requests;
+	std::vector<MPI_Request> contentRequests; // Raw Content sends, if Content is trivially packable
+	bool packContent = is_trivially_packable<Content>::value;
+	bool packAll = packContent && context.projectionInfoIsPackable(); // Projection info travels with the Content
+	std::list<std::vector<char> > packedData; // Raw sends, if packAll
 
 	// STEP 5: Create the receives
 	std::vector<SyncStatus_Packet<Content>*> packetsRecd;
@@ -1038,7 +1280,7 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 			iter != psToReceiveFrom.end(); ++iter) {
 		int source = *iter;
 		SyncStatus_Packet<Content>* packetToRecv =
-				new SyncStatus_Packet<Content>;
+				new SyncStatus_Packet<Content>(packAll);
 		requests.push_back(
 				world->irecv(source, AGENT_MOVED_AGENT, *packetToRecv));
 		packetsRecd.push_back(packetToRecv);
@@ -1055,9 +1297,7 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 		provider.provideContent(iter->second, *content);
 
 		// Projection Info and Secondary Ids
-		std::map<std::string, std::vector<ProjectionInfoPacket*> >* projInfo =
-				new std::map<std::string,
-						std::vector<repast::ProjectionInfoPacket*> >;
+		ProjectionInfoByOrdinal* projInfo = new ProjectionInfoByOrdinal;
 		std::set<AgentId>* secondaryIds = (
 				sendSecondaryData ? new std::set<AgentId> : 0);
 		context.getProjectionInfo(iter->second, *projInfo, sendSecondaryData,
@@ -1080,22 +1320,45 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 		SyncStatus_Packet<Content>* packetToSend;
 		packetsToSend->push_back(
 				packetToSend = new SyncStatus_Packet<Content>(content, projInfo,
-						secondaryIds, agentImporterInfoPtr));
+						secondaryIds, agentImporterInfoPtr, packAll));
 
 		requests.push_back(
 				world->isend(iter->first, AGENT_MOVED_AGENT, *packetToSend));
+		if (packAll) {
+			packedData.push_back(std::vector<char>());
+			packAgentData(context, *content, *projInfo, packedData.back());
+			isendContent(iter->first, AGENT_MOVED_CONTENT, packedData.back(), contentRequests);
+		} else if (packContent) {
+			isendContent(iter->first, AGENT_MOVED_CONTENT, *content, contentRequests);
+		}
 	}
 	boost::mpi::wait_all(requests.begin(), requests.end());
+	if (packContent) {
+		std::vector<char> received;
+		for (size_t i = 0; i < packetsRecd.size(); ++i) {
+			packetsRecd[i]->agentContentPtr = new std::vector<Content>;
+			if (packAll) {
+				packetsRecd[i]->projectionInfoPtr = new ProjectionInfoByOrdinal;
+				recvContent(psToReceiveFrom[i], AGENT_MOVED_CONTENT, received);
+				unpackAgentData(context, received, *(packetsRecd[i]->agentContentPtr),
+						*(packetsRecd[i]->projectionInfoPtr));
+			} else {
+				recvContent(psToReceiveFrom[i], AGENT_MOVED_CONTENT, *(packetsRecd[i]->agentContentPtr));
+			}
+		}
+		waitForContentSends(contentRequests);
+	}
 	delete packetsToSend;
 
 	importer_exporter->clearAgentExportInfo();
 
 	// STEP 9: Remove the agents that are moving to other processes and are not needed here
-	std::set<AgentId> agentsToKeep;
+	AgentIdSet& agentsToKeep = syncAgentsToKeep;
+	agentsToKeep.clear();
 	context.getRequiredAgents(agentsToDrop, agentsToKeep,
 			Projection<T>::SECONDARY);
 
-	for (std::set<AgentId>::iterator idIter = agentsToDrop.begin(), idIterEnd =
+	for (AgentIdSet::const_iterator idIter = agentsToDrop.begin(), idIterEnd =
 			agentsToDrop.end(); idIter != idIterEnd; ++idIter)
 		context.removeAgent(*idIter);
 
@@ -1155,6 +1418,27 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 
 }
 
+template<typename Content>
+void RepastProcess::isendContent(int dest, int tag,
+		std::vector<Content>& content, std::vector<MPI_Request>& requests) {
+	MPI_Request req;
+	MPI_Isend(content.empty() ? 0 : &content[0], content.size() * sizeof(Content),
+			MPI_BYTE, dest, tag, *world, &req);
+	requests.push_back(req);
+}
+
+template<typename Content>
+void RepastProcess::recvContent(int source, int tag,
+		std::vector<Content>& content) {
+	MPI_Status status;
+	MPI_Probe(source, tag, *world, &status);
+	int bytes;
+	MPI_Get_count(&status, MPI_BYTE, &bytes);
+	content.resize(bytes / sizeof(Content));
+	MPI_Recv(content.empty() ? 0 : &content[0], bytes, MPI_BYTE, source, tag,
+			*world, MPI_STATUS_IGNORE);
+}
+
 }
 
 #endif /* REPASTPROCESS_H_ */
@@ -38,12 +38,43 @@
  */
 
 #include "SRManager.h"
+#include "mpi_constants.h"
 
 #include <boost/mpi.hpp>
 
 using namespace std;
 
-SRManager::SRManager(boost::mpi::communicator* comm): _comm(comm){
+namespace {
+
+int roundKeyval = MPI_KEYVAL_INVALID;
+
+int deleteRound(MPI_Comm comm, int keyval, void* attributeVal, void* extraState){
+  delete static_cast<int*>(attributeVal);
+  return MPI_SUCCESS;
+}
+
+/**
+ * Gets the tag for the next NBX exchange on the communicator. Consecutive
+ * exchanges alternate between two tags: a process that has seen the barrier
+ * complete may begin sending for the next exchange while a neighbor is still
+ * probing for messages from the previous one. The round count is cached on
+ * the communicator itself, so it stays consistent across all of its members.
+ */
+int nextNBXTag(MPI_Comm comm){
+  if(roundKeyval == MPI_KEYVAL_INVALID) MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, deleteRound, &roundKeyval, 0);
+  int* round;
+  int found;
+  MPI_Comm_get_attr(comm, roundKeyval, &round, &found);
+  if(!found){
+    round = new int(0);
+    MPI_Comm_set_attr(comm, roundKeyval, round);
+  }
+  return ((*round)++ % 2 == 0 ? repast::SR_NBX_EVEN : repast::SR_NBX_ODD);
+}
+
+}
+
+SRManager::SRManager(boost::mpi::communicator* comm, Engine engine): _comm(comm), _engine(engine){
   int s = _comm->size();
   mySend = new int[s];
   myRecv = new int[s];
@@ -52,7 +83,7 @@ SRManager::SRManager(boost::mpi::communicator* comm): _comm(comm){
   clear();
 }
 
-SRManager::SRManager(boost::mpi::communicator* comm, int* toSend, int* toRecv): _comm(comm), send(toSend), recv(toRecv){
+SRManager::SRManager(boost::mpi::communicator* comm, int* toSend, int* toRecv, Engine engine): _comm(comm), send(toSend), recv(toRecv), _engine(engine){
   mySend = NULL;
   myRecv = NULL;
   if(recv == NULL){
@@ -84,7 +115,89 @@ void SRManager::clear(){
 }
 
 void SRManager::retrieveSources(){
-  MPI_Alltoall(send, 1, MPI_INT, recv, 1, MPI_INT, (*_comm));
+  switch(_engine){
+    case REDUCE_SCATTER:
+      retrieveSourcesReduceScatter();
+      break;
+    case NBX:
+      retrieveSourcesNBX();
+      break;
+    default:
+      MPI_Alltoall(send, 1, MPI_INT, recv, 1, MPI_INT, (*_comm));
+  }
+}
+
+void SRManager::retrieveSourcesReduceScatter(){
+  const int size = _comm->size();
+  const int rank = _comm->rank();
+
+  // Count of values each process will receive; self is handled locally
+  std::vector<int> counts(size, 0);
+  std::vector<int> targets;
+  for(int i = 0; i < size; i++){
+    if(send[i] != 0 && i != rank){
+      counts[i] = 1;
+      targets.push_back(i);
+    }
+  }
+  int expected = 0;
+  MPI_Reduce_scatter_block(&counts[0], &expected, 1, MPI_INT, MPI_SUM, (*_comm));
+
+  for(int i = 0; i < size; i++) recv[i] = 0;
+  recv[rank] = send[rank];
+
+  // No message from a later exchange can arrive before this one completes,
+  // because every process must first join that exchange's reduce-scatter.
+  std::vector<MPI_Request> requests(targets.size());
+  for(size_t i = 0; i < targets.size(); i++) MPI_Isend(&send[targets[i]], 1, MPI_INT, targets[i], repast::SR_REDUCE_SCATTER, (*_comm), &requests[i]);
+  for(int i = 0; i < expected; i++){
+    int val;
+    MPI_Status status;
+    MPI_Recv(&val, 1, MPI_INT, MPI_ANY_SOURCE, repast::SR_REDUCE_SCATTER, (*_comm), &status);
+    recv[status.MPI_SOURCE] = val;
+  }
+  if(!requests.empty()) MPI_Waitall(requests.size(), &requests[0], MPI_STATUSES_IGNORE);
+}
+
+void SRManager::retrieveSourcesNBX(){
+  const int size = _comm->size();
+  const int rank = _comm->rank();
+  const int tag = nextNBXTag(*_comm);
+
+  for(int i = 0; i < size; i++) recv[i] = 0;
+  recv[rank] = send[rank];
+
+  std::vector<MPI_Request> sends;
+  for(int i = 0; i < size; i++){
+    if(send[i] != 0 && i != rank){
+      MPI_Request req;
+      MPI_Issend(&send[i], 1, MPI_INT, i, tag, (*_comm), &req);
+      sends.push_back(req);
+    }
+  }
+
+  MPI_Request barrier;
+  bool barrierActive = false;
+  while(true){
+    int flag;
+    MPI_Status status;
+    MPI_Iprobe(MPI_ANY_SOURCE, tag, (*_comm), &flag, &status);
+    if(flag) MPI_Recv(&recv[status.MPI_SOURCE], 1, MPI_INT, status.MPI_SOURCE, tag, (*_comm), MPI_STATUS_IGNORE);
+
+    if(barrierActive){
+      int done;
+      MPI_Test(&barrier, &done, MPI_STATUS_IGNORE);
+      if(done) break;
+    }
+    else{
+      int sent = 1;
+      if(!sends.empty()) MPI_Testall(sends.size(), &sends[0], &sent, MPI_STATUSES_IGNORE);
+      if(sent){
+        MPI_Ibarrier((*_comm), &barrier);
+        barrierActive = true;
+      }
+    }
+  }
 }
 
 void SRManager::retrieveSources(std::vector<int>& sources){
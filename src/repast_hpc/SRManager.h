@@ -48,23 +48,51 @@
  * Coordinates send and receive between processes
  * by notifying processes to expect a send from
  * X other processes.
+ *
+ * The exchange itself can be performed by one of several
+ * engines:
+ *
+ *   ALLTOALL: a single MPI_Alltoall of one int per process. Cost is
+ *     O(P) per process regardless of how many values are non-zero.
+ *   REDUCE_SCATTER: an MPI_Reduce_scatter_block of the per-process
+ *     message counts, followed by point-to-point messages carrying
+ *     the non-zero values only.
+ *   NBX: the non-blocking consensus algorithm; synchronous sends of
+ *     the non-zero values, with an MPI_Ibarrier entered once they have
+ *     all been matched. No collective over per-process data is used.
+ *
+ * The sparse engines are preferable when each process sends to a small
+ * number of others. All processes must use the same engine for a given
+ * exchange. The engine RepastProcess uses for POLL exchanges is set with
+ * RepastProcess::setSourceRetrievalEngine; RepastProcess::requestAgents
+ * does not use SRManager (see RepastProcess::AGENT_REQUEST_EXCHANGE).
  */
 class SRManager{
 
+public:
+  enum Engine {
+    ALLTOALL, REDUCE_SCATTER, NBX
+  };
+
 private:
   boost::mpi::communicator* _comm;
   int *send;
   int *recv;
   int *mySend;
   int *myRecv;
+  Engine _engine;
+
+  void retrieveSourcesReduceScatter();
+  void retrieveSourcesNBX();
 
 public:
   /**
    * Creates an SRManager that uses the specified communicator.
    *
    * @param comm the communicator to use
+   * @param engine the engine used to perform the exchange
    */
-  SRManager(boost::mpi::communicator* comm);
+  SRManager(boost::mpi::communicator* comm, Engine engine = ALLTOALL);
 
   /**
    * Creates an SRManager that uses the specified communicator,
@@ -80,8 +108,9 @@ public:
    *   array will be used. This is to provide for situations in which
    *   the user wishes to maintain the send array but not the receive
    *   array.
+   * @param engine the engine used to perform the exchange
    */
-  SRManager(boost::mpi::communicator* comm, int* toSend, int* toRecv);
+  SRManager(boost::mpi::communicator* comm, int* toSend, int* toRecv, Engine engine = ALLTOALL);
 
   ~SRManager();
 
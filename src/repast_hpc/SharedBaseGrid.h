@@ -163,9 +163,12 @@ std::ostream& operator<<(std::ostream& os, const Neighbors& nghs);
  * @tparam Adder determines how objects are added to the grid from its associated context.
  * @tparam GPType the coordinate type of the grid point locations. This must
  * be an int or a double.
+ * @tparam CellAccessor implements the actual storage for the grid. It is
+ * initialized with the local bounds plus the buffer.
  */
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-class SharedBaseGrid: public BaseGrid<T, MultipleOccupancy<T, GPType> , GPTransformer, Adder, GPType> {
+template<typename T, typename GPTransformer, typename Adder, typename GPType,
+		typename CellAccessor = MultipleOccupancy<T, GPType> >
+class SharedBaseGrid: public BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType> {
 
 private:
   CartesianTopology* cartTopology;
@@ -182,9 +185,48 @@ protected:
 	virtual void synchMoveTo(const AgentId& id, const Point<GPType>& pt) = 0;
 
 	int rank;
-	typedef typename repast::BaseGrid<T, MultipleOccupancy<T, GPType> , GPTransformer, Adder, GPType> GridBaseType;
+	typedef typename repast::BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType> GridBaseType;
 	boost::mpi::communicator* comm;
 
+	// doc inherited from BaseGrid.h
+	virtual int agentMoved(const AgentId& id, int zone, const typename GridBaseType::PointType& location);
+
+	// doc inherited from BaseGrid.h
+	virtual void agentRemoved(const AgentId& id, int zone);
+
+private:
+	// Agents' buffer zones are classified as they move. A zone has bit 2i set
+	// when the agent lies in the low buffer strip of dimension i and bit 2i + 1
+	// when it lies in the high one; agents outside the local bounds are in
+	// OUT_OF_BOUNDS and agents in the interior are in zone 0.
+	static const int OUT_OF_BOUNDS = 1 << 30;
+
+	struct ZoneChange {
+		AgentId id;
+		int from, to;
+	};
+
+	struct ZoneChangeLess {
+		bool operator()(const ZoneChange& one, const ZoneChange& two) const {
+			return one.id < two.id;
+		}
+	};
+
+	// relative location and rank of each neighbor, and the agents in the
+	// buffer strip that neighbor sees as of the last flush
+	std::vector<std::vector<int> > stripLocations;
+	std::vector<int> stripRanks;
+	std::vector<AgentIdSet> stripAgents;
+	AgentIdSet outOfBounds;
+
+	// zone transitions since the last flush, in the order they happened
+	std::vector<ZoneChange> zoneChanges;
+	std::vector<AgentIdSet> stripLeaving;
+	AgentIdSet outLeaving;
+
+	bool inStrip(int zone, size_t strip) const;
+	void flushZoneChanges();
+
 public:
   void balance();
 
@@ -237,9 +279,9 @@ public:
 
 	// doc inherited from Projection.h
 
-  virtual void getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsRequired){ } // Grids don't keep agents
+  virtual void getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsRequired){ } // Grids don't keep agents
 
-  virtual void getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush);
+  virtual void getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush);
 
 
   virtual void getInfoExchangePartners(std::set<int>& psToSendTo, std::set<int>& psToReceiveFrom){
@@ -256,8 +298,8 @@ public:
 
 };
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-SharedBaseGrid<T, GPTransformer, Adder, GPType>::SharedBaseGrid(std::string name, GridDimensions gridDims, std::vector<
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::SharedBaseGrid(std::string name, GridDimensions gridDims, std::vector<
 		int> processDims, int buffer, boost::mpi::communicator* communicator) :
 	GridBaseType(name, gridDims), _buffer(buffer), comm(communicator), globalBounds(gridDims) {
 
@@ -276,6 +318,13 @@ SharedBaseGrid<T, GPTransformer, Adder, GPType>::SharedBaseGrid(std::string name
 	localBounds = cartTopology->getDimensions(rank, gridDims);
 	GridBaseType::adder.init(localBounds, this);
 
+	std::vector<double> bufferedOrigin(dimCount), bufferedExtents(dimCount);
+	for (int i = 0; i < dimCount; i++) {
+		bufferedOrigin[i] = localBounds.origin(i) - _buffer;
+		bufferedExtents[i] = localBounds.extents(i) + 2 * _buffer;
+	}
+	GridBaseType::cellAccessor.init(GridDimensions(Point<double> (bufferedOrigin), Point<double> (bufferedExtents)));
+
   RelativeLocation relLocUntrimmed(dimCount);
   RelativeLocation relLoc = cartTopology->trim(rank, relLocUntrimmed);
 
@@ -287,19 +336,24 @@ SharedBaseGrid<T, GPTransformer, Adder, GPType>::SharedBaseGrid(std::string name
     if(rankOfNeighbor != rank && rankOfNeighbor != MPI_PROC_NULL){ // Note: the test for MPI_PROC_NULL is vestigial; by trimming the Relative Location, there should never be any
       Neighbor* ngh = new Neighbor(rankOfNeighbor, cartTopology->getDimensions(rankOfNeighbor, gridDims));
       nghs->addNeighbor(ngh, relLoc);
+      stripLocations.push_back(currentVal);
+      stripRanks.push_back(rankOfNeighbor);
     }
   }while(relLoc.increment());
 
+  stripAgents.resize(stripRanks.size());
+  stripLeaving.resize(stripRanks.size());
+
 }
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-SharedBaseGrid<T, GPTransformer, Adder, GPType>::~SharedBaseGrid() {
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::~SharedBaseGrid() {
   delete nghs;
 }
 
 
-//template<typename T, typename GPTransformer, typename Adder, typename GPType>
-//GridDimensions SharedBaseGrid<T, GPTransformer, Adder, GPType>::createSendBufferBounds(std::vector<int> relativeLocation) {
+//template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+//GridDimensions SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::createSendBufferBounds(std::vector<int> relativeLocation) {
 //	Point<double> localOrigin = localBounds.origin();
 //	Point<double> localExtent = localBounds.extents();
 //
@@ -340,145 +394,146 @@ SharedBaseGrid<T, GPTransformer, Adder, GPType>::~SharedBaseGrid() {
 //}
 
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-void SharedBaseGrid<T, GPTransformer, Adder, GPType>::balance() {
-  int r = comm->rank();
-  typename GridBaseType::LocationMapConstIter iterEnd = GridBaseType::locationsEnd();
-  for (typename GridBaseType::LocationMapConstIter iter = GridBaseType::locationsBegin(); iter != iterEnd; ++iter) {
-    AgentId id = iter->second->ptr->getId();
-    if(id.currentRank() == r){                                   // Local agents only
-      Point<GPType> loc = iter->second->point;
-      if(!localBounds.contains(loc)){                            // If inside bounds, ignore
-        Neighbor* ngh = nghs->findNeighbor(loc.coords());
-        RepastProcess::instance()->moveAgent(id, ngh->rank());
-      }
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+int SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::agentMoved(const AgentId& id, int zone,
+    const typename GridBaseType::PointType& location) {
+  int newZone = 0;
+  for (size_t i = 0, n = localBounds.dimensionCount(); i < n; i++) {
+    double start = localBounds.origin(i);
+    double end = start + localBounds.extents(i);
+    if (location[i] < start || location[i] >= end) {
+      newZone = OUT_OF_BOUNDS;
+      break;
     }
+    if (location[i] < start + _buffer) newZone |= 1 << (2 * i);
+    if (location[i] >= end - _buffer)  newZone |= 2 << (2 * i);
   }
+  if (newZone != zone) {
+    ZoneChange change = { id, zone, newZone };
+    zoneChanges.push_back(change);
+  }
+  return newZone;
 }
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-bool SharedBaseGrid<T, GPTransformer, Adder, GPType>::moveTo(const AgentId& id, const Point<GPType>& newLocation) {
-	return SharedBaseGrid<T, GPTransformer, Adder, GPType>::moveTo(id, newLocation.coords());
-}
-
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-bool SharedBaseGrid<T, GPTransformer, Adder, GPType>::moveTo(const AgentId& id, const std::vector<GPType>& newLocation) {
-	return GridBaseType::moveTo(id, newLocation);
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::agentRemoved(const AgentId& id, int zone) {
+  if (zone != 0) {
+    ZoneChange change = { id, zone, 0 };
+    zoneChanges.push_back(change);
+  }
 }
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-void SharedBaseGrid<T, GPTransformer, Adder, GPType>::removeAgent(T* agent) {
-	GridBaseType::removeAgent(agent);
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+bool SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::inStrip(int zone, size_t strip) const {
+  if (zone == OUT_OF_BOUNDS) return false;
+  const std::vector<int>& relLoc = stripLocations[strip];
+  for (size_t i = 0, n = relLoc.size(); i < n; i++) {
+    if (relLoc[i] < 0 && (zone & (1 << (2 * i))) == 0) return false;
+    if (relLoc[i] > 0 && (zone & (2 << (2 * i))) == 0) return false;
+  }
+  return true;
 }
 
+/**
+ * Applies the zone transitions recorded since the last flush to the strip
+ * and out of bounds sets. Only an agent's first and last zones matter, so the
+ * transitions are grouped by agent, and the agents leaving each set are
+ * removed from it in a single pass.
+ */
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::flushZoneChanges() {
+  if (zoneChanges.empty()) return;
+
+  std::stable_sort(zoneChanges.begin(), zoneChanges.end(), ZoneChangeLess());
+  size_t numStrips = stripAgents.size();
+  for (size_t s = 0; s < numStrips; s++) stripLeaving[s].clear();
+  outLeaving.clear();
+
+  for (size_t i = 0, n = zoneChanges.size(); i < n;) {
+    size_t last = i;
+    while (last + 1 < n && zoneChanges[last + 1].id == zoneChanges[i].id) last++;
+
+    const AgentId& id = zoneChanges[i].id;
+    int from = zoneChanges[i].from;
+    int to = zoneChanges[last].to;
+    if (from != to) {
+      for (size_t s = 0; s < numStrips; s++) {
+        bool was = inStrip(from, s);
+        bool is = inStrip(to, s);
+        if (is && !was)       stripAgents[s].insert(id);
+        else if (was && !is)  stripLeaving[s].insert(id);
+      }
+      if (to == OUT_OF_BOUNDS)        outOfBounds.insert(id);
+      else if (from == OUT_OF_BOUNDS) outLeaving.insert(id);
+    }
+    i = last + 1;
+  }
 
-// Beta
-
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-void SharedBaseGrid<T, GPTransformer, Adder, GPType>::getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush){
-
-  if(_buffer == 0) return; // A buffer zone of zero means that no agents will be pushed.
-
-  int numDims = localBounds.dimensionCount();
-  RelativeLocation relLocOrig(numDims);
-
-  RelativeLocation relLoc = cartTopology->trim(comm->rank(), relLocOrig);
+  for (size_t s = 0; s < numStrips; s++) stripAgents[s].erase(stripLeaving[s]);
+  outOfBounds.erase(outLeaving);
+  zoneChanges.clear();
+}
 
-  // First, create a zone around the center of this process, inside all of
-  // of the buffer zones
-  std::vector<double> unbufferedOrigin;
-  std::vector<double> unbufferedExtents;
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::balance() {
+  flushZoneChanges();
 
-  for(int i = 0; i < numDims; i++){
-    bool hasLeft  = relLoc.getMinimumAt(i) < 0;
-    bool hasRight = relLoc.getMaximumAt(i) > 0;
-    unbufferedOrigin.push_back(localBounds.origin(i) + (hasLeft ? _buffer : 0));
-    unbufferedExtents.push_back(localBounds.extents(i) - (hasLeft ? _buffer : 0) - (hasRight ? _buffer : 0));
+  int r = comm->rank();
+  std::vector<GPType> loc;
+  for (AgentIdSet::const_iterator iter = outOfBounds.begin(), iterEnd = outOfBounds.end(); iter != iterEnd; ++iter) {
+    T* agent = GridBaseType::get(*iter);
+    if(agent != 0 && agent->getId().currentRank() == r){         // Local agents only
+      GridBaseType::getLocation(*iter, loc);
+      Neighbor* ngh = nghs->findNeighbor(loc);
+      RepastProcess::instance()->moveAgent(agent->getId(), ngh->rank());
+    }
   }
+}
 
-  Point<double> ubO(unbufferedOrigin);
-  Point<double> ubE(unbufferedExtents);
-  GridDimensions unbuffered(ubO, ubE);
-
-  // And create grid boundaries for all the buffer zones
-  int numOutgoing = relLoc.getMaxIndex() + 1;
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+bool SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::moveTo(const AgentId& id, const Point<GPType>& newLocation) {
+	return SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::moveTo(id, newLocation.coords());
+}
 
-  GridDimensions** outgoing = new GridDimensions*[numOutgoing];
-  int*             outRanks = new int[numOutgoing];
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+bool SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::moveTo(const AgentId& id, const std::vector<GPType>& newLocation) {
+	return GridBaseType::moveTo(id, newLocation);
+}
 
-  do{
-    std::vector<double> bufferOrigin;
-    std::vector<double> bufferExtents;
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::removeAgent(T* agent) {
+	GridBaseType::removeAgent(agent);
+}
 
-    bool isEgo = true;
-    for(int i = 0; i < numDims; i++){
-      int rel = relLoc[i];
 
-      if(rel == 0){
-        bufferOrigin.push_back(localBounds.origin(i));
-        bufferExtents.push_back(localBounds.extents(i));
-      }
-      else{
-        if(rel < 0){
-          bufferOrigin.push_back(localBounds.origin(i));
-        }
-        else{
-          bufferOrigin.push_back(localBounds.origin(i) + localBounds.extents(i) - _buffer);
-        }
-        bufferExtents.push_back(_buffer);
-        isEgo = false;
-      }
-    }
+// Beta
 
-    // Should not add self!
-    int index = relLoc.getIndex();
-    if(!isEgo){
-      outgoing[index] = new GridDimensions(Point<double>(bufferOrigin), Point<double> (bufferExtents));
-      outRanks[index]  =nghs->getNeighborByIndex(index)->rank();
-    }
-    else{
-      outgoing[index] = 0;
-      outRanks[index] = 0;
-    }
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush){
 
-  }while(relLoc.increment());
+  if(_buffer == 0) return; // A buffer zone of zero means that no agents will be pushed.
 
+  flushZoneChanges();
 
   // Local agents that are in other processes' 'buffer zones' must be exported to those other processes.
+  // Pushed agents are removed from agentsToTest in one pass at the end
   int r = comm->rank();
-  std::set<AgentId>::iterator idIter = agentsToTest.begin();
-  while(idIter != agentsToTest.end()){
-    AgentId id = *idIter;
-    bool found = false;
-    if(id.currentRank() == r){ // Local agents only
-      std::vector<GPType> locationVector;
-      GridBaseType::getLocation(id, locationVector);
-      Point<GPType> loc(locationVector);
-      if(!unbuffered.contains(loc)){
-        for(int i = 0; i < numOutgoing; i++){
-          if ((outgoing[i] != NULL) && (outgoing[i]->contains(loc))) {
-            agentsToPush[outRanks[i]].insert(id);
-            found = true;
-          }
-        }
+  AgentIdSet pushed;
+  for(size_t s = 0, numStrips = stripAgents.size(); s < numStrips; s++){
+    const AgentIdSet& agents = stripAgents[s];
+    for(AgentIdSet::const_iterator idIter = agents.begin(), idIterEnd = agents.end(); idIter != idIterEnd; ++idIter){
+      AgentIdSet::const_iterator found = agentsToTest.find(*idIter);
+      if(found != agentsToTest.end() && found->currentRank() == r){ // Local agents only
+        agentsToPush[stripRanks[s]].insert(*found);
+        pushed.insert(*found);
       }
     }
-    if(found){
-      std::set<AgentId>::iterator tmp = idIter;
-      idIter++;
-      agentsToTest.erase(tmp);
-    }
-    else{
-      idIter++;
-    }
   }
-//  if(NW_set.size() > 0) agentsToPush[NW_rank].insert(NW_set.begin(), NW_set.end());
-  delete[] outgoing;
-  delete[] outRanks;
+  agentsToTest.erase(pushed);
 }
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-void SharedBaseGrid<T, GPTransformer, Adder, GPType>::updateProjectionInfo(ProjectionInfoPacket* pip, Context<T>* context){
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::updateProjectionInfo(ProjectionInfoPacket* pip, Context<T>* context){
   SpecializedProjectionInfoPacket<GPType>* spip = static_cast<SpecializedProjectionInfoPacket<GPType>*>(pip);
   synchMoveTo(spip->id, spip->data);
 }
@@ -126,6 +126,9 @@ private:
 	RefMap projRefMap;
 	int _rank;
 
+	// the local agents tested by getAgentsToPushToOtherProcesses, kept to reuse its storage
+	AgentIdSet localAgentsToTest;
+
 public:
 
 	// Create single instances for these and reuse them
@@ -327,10 +330,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -347,10 +349,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -371,10 +372,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -397,10 +397,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -420,10 +419,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -442,10 +440,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -467,10 +464,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -494,10 +490,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -518,10 +513,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -544,10 +538,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -573,10 +566,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -604,10 +596,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -632,10 +623,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -659,10 +649,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -689,10 +678,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original set will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -722,10 +710,9 @@ public:
 	 * If the 'remove' parameter is set to true, any elements in the
 	 * original vector will be removed before the method returns.
 	 *
-	 * The popSize parameter is used when the method is repeatedly called
-	 * on a population whose size is known. Calls to this method typically begin
-	 * by determining the size of the (valid) population to be sampled; if this is known,
-	 * it can be provided here, improving performance.
+	 * The popSize parameter is accepted for compatibility but is no longer
+	 * needed: agents are sampled directly from the context's agent index, so
+	 * the size of the (valid) population is never counted.
 	 *
 	 * @param localOrNonLocalOnly flag that indicates that the agents selected
 	 * will be drawn only from agents either local or non-local to this process
@@ -764,15 +751,15 @@ public:
    * Given a set of agents to test, returns the set of those agents that must be kept in order
    * to keep required projection information.
    */
-  void getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsToKeep, RADIUS radius = Projection<T>::PRIMARY);
+  void getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsToKeep, RADIUS radius = Projection<T>::PRIMARY);
 
   /**
    * Given an initial set of agents that must be kept a priori, add any agents that must be kept due to
    * projection requirements, and return the set of all non-local agents that can be dropped.
    */
-  void getNonlocalAgentsToDrop(std::set<AgentId>& agentsToKeep, std::set<AgentId>& agentsToDrop, RADIUS radius = Projection<T>::PRIMARY);
+  void getNonlocalAgentsToDrop(AgentIdSet& agentsToKeep, AgentIdSet& agentsToDrop, RADIUS radius = Projection<T>::PRIMARY);
 
-  void getAgentsToPushToOtherProcesses(std::map<int, std::set<AgentId> >& agentsToPush);
+  void getAgentsToPushToOtherProcesses(std::map<int, AgentIdSet>& agentsToPush);
 
   virtual void addProjection(Projection<T>* projection);
 
@@ -904,106 +891,134 @@ boost::filter_iterator<filterStruct, typename SharedContext<T>::const_state_awar
 
 template<typename T>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, std::set<T*>& selectedAgents, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(begin(localOrNonLocalOnly), end(localOrNonLocalOnly), size(), selectedAgents, remove);
-	else              selectNElementsAtRandom(begin(localOrNonLocalOnly), popSize, size(), selectedAgents, remove);
+	AgentStateFilter<T>& accept = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+
+	this->selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 
 template<typename T>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, std::vector<T*>& selectedAgents, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(begin(localOrNonLocalOnly), end(localOrNonLocalOnly), size(), selectedAgents, remove);
-	else              selectNElementsInRandomOrder(begin(localOrNonLocalOnly), popSize, size(), selectedAgents, remove);
+	AgentStateFilter<T>& accept = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+
+	this->selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 
 template<typename T>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, int count, std::set<T*>& selectedAgents, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(begin(localOrNonLocalOnly), end(localOrNonLocalOnly), count, selectedAgents, remove);
-	else              selectNElementsAtRandom(begin(localOrNonLocalOnly), popSize, count, selectedAgents, remove);
+	AgentStateFilter<T>& accept = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+
+	this->selectSampledAgents(count, selectedAgents, remove, accept);
 }
 
 template<typename T>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, int count, std::vector<T*>& selectedAgents, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(begin(localOrNonLocalOnly), end(localOrNonLocalOnly), count, selectedAgents, remove);
-	else              selectNElementsInRandomOrder(begin(localOrNonLocalOnly), popSize, count, selectedAgents, remove);
+	AgentStateFilter<T>& accept = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+
+	this->selectSampledAgents(count, selectedAgents, remove, accept);
 }
 
 template<typename T>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, std::set<T*>& selectedAgents, int type, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(byTypeBegin(localOrNonLocalOnly, type), byTypeEnd(localOrNonLocalOnly, type), size(), selectedAgents, remove);
-	else              selectNElementsAtRandom(byTypeBegin(localOrNonLocalOnly, type), popSize, size(), selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	IsAgentType<T> isType(type);
+	BothFilters<T, AgentStateFilter<T>, IsAgentType<T> > accept(isLocal, isType);
+	this->selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 
 template<typename T>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, std::vector<T*>& selectedAgents, int type, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(byTypeBegin(localOrNonLocalOnly, type), byTypeEnd(localOrNonLocalOnly, type), size(), selectedAgents, remove);
-	else              selectNElementsInRandomOrder(byTypeBegin(localOrNonLocalOnly, type), popSize, size(), selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	IsAgentType<T> isType(type);
+	BothFilters<T, AgentStateFilter<T>, IsAgentType<T> > accept(isLocal, isType);
+	this->selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 
 template<typename T>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, int count, std::set<T*>& selectedAgents, int type, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(byTypeBegin(localOrNonLocalOnly, type), byTypeEnd(localOrNonLocalOnly, type), count, selectedAgents, remove);
-	else              selectNElementsAtRandom(byTypeBegin(localOrNonLocalOnly, type), popSize, count, selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	IsAgentType<T> isType(type);
+	BothFilters<T, AgentStateFilter<T>, IsAgentType<T> > accept(isLocal, isType);
+	this->selectSampledAgents(count, selectedAgents, remove, accept);
 }
 
 template<typename T>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, int count, std::vector<T*>& selectedAgents, int type, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(byTypeBegin(localOrNonLocalOnly, type), byTypeEnd(localOrNonLocalOnly, type), count, selectedAgents, remove);
-	else              selectNElementsInRandomOrder(byTypeBegin(localOrNonLocalOnly, type), popSize, count, selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	IsAgentType<T> isType(type);
+	BothFilters<T, AgentStateFilter<T>, IsAgentType<T> > accept(isLocal, isType);
+	this->selectSampledAgents(count, selectedAgents, remove, accept);
 }
 
 template<typename T>
 template<typename filterStruct>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, std::set<T*>& selectedAgents, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(filteredBegin(localOrNonLocalOnly, filter), filteredEnd(localOrNonLocalOnly, filter), size(), selectedAgents, remove);
-	else              selectNElementsAtRandom(filteredBegin(localOrNonLocalOnly, filter), popSize, size(), selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	BothFilters<T, AgentStateFilter<T>, filterStruct> accept(isLocal, filter);
+	this->selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 
 template<typename T>
 template<typename filterStruct>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, std::vector<T*>& selectedAgents, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(filteredBegin(localOrNonLocalOnly, filter), filteredEnd(localOrNonLocalOnly, filter), size(), selectedAgents, remove);
-	else              selectNElementsInRandomOrder(filteredBegin(localOrNonLocalOnly, filter), popSize, size(), selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	BothFilters<T, AgentStateFilter<T>, filterStruct> accept(isLocal, filter);
+	this->selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 
 template<typename T>
 template<typename filterStruct>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, int count, std::set<T*>& selectedAgents, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(filteredBegin(localOrNonLocalOnly, filter), filteredEnd(localOrNonLocalOnly, filter), count, selectedAgents, remove);
-	else              selectNElementsAtRandom(filteredBegin(localOrNonLocalOnly, filter), popSize, count, selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	BothFilters<T, AgentStateFilter<T>, filterStruct> accept(isLocal, filter);
+	this->selectSampledAgents(count, selectedAgents, remove, accept);
 }
 
 template<typename T>
 template<typename filterStruct>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, int count, std::vector<T*>& selectedAgents, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(filteredBegin(localOrNonLocalOnly, filter), filteredEnd(localOrNonLocalOnly, filter), count, selectedAgents, remove);
-	else              selectNElementsInRandomOrder(filteredBegin(localOrNonLocalOnly, filter), popSize, count, selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	BothFilters<T, AgentStateFilter<T>, filterStruct> accept(isLocal, filter);
+	this->selectSampledAgents(count, selectedAgents, remove, accept);
 }
 
 template<typename T>
 template<typename filterStruct>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, std::set<T*>& selectedAgents, int type, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(byTypeFilteredBegin(localOrNonLocalOnly, type, filter), byTypeFilteredEnd(localOrNonLocalOnly, type, filter), size(), selectedAgents, remove);
-	else              selectNElementsAtRandom(byTypeFilteredBegin(localOrNonLocalOnly, type, filter), popSize, size(), selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	IsAgentType<T> isType(type);
+	BothFilters<T, IsAgentType<T>, filterStruct> typeAndFilter(isType, filter);
+	BothFilters<T, AgentStateFilter<T>, BothFilters<T, IsAgentType<T>, filterStruct> > accept(isLocal, typeAndFilter);
+	this->selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 
 template<typename T>
 template<typename filterStruct>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, std::vector<T*>& selectedAgents, int type, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(byTypeFilteredBegin(localOrNonLocalOnly, type, filter), byTypeFilteredEnd(localOrNonLocalOnly, type, filter), size(), selectedAgents, remove);
-	else              selectNElementsInRandomOrder(byTypeFilteredBegin(localOrNonLocalOnly, type, filter), popSize, size(), selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	IsAgentType<T> isType(type);
+	BothFilters<T, IsAgentType<T>, filterStruct> typeAndFilter(isType, filter);
+	BothFilters<T, AgentStateFilter<T>, BothFilters<T, IsAgentType<T>, filterStruct> > accept(isLocal, typeAndFilter);
+	this->selectSampledAgents(size(), selectedAgents, remove, accept);
 }
 
 template<typename T>
 template<typename filterStruct>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, int count, std::set<T*>& selectedAgents, int type, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsAtRandom(byTypeFilteredBegin(localOrNonLocalOnly, type, filter), byTypeFilteredEnd(localOrNonLocalOnly, type, filter), count, selectedAgents, remove);
-	else              selectNElementsAtRandom(byTypeFilteredBegin(localOrNonLocalOnly, type, filter), popSize, count, selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	IsAgentType<T> isType(type);
+	BothFilters<T, IsAgentType<T>, filterStruct> typeAndFilter(isType, filter);
+	BothFilters<T, AgentStateFilter<T>, BothFilters<T, IsAgentType<T>, filterStruct> > accept(isLocal, typeAndFilter);
+	this->selectSampledAgents(count, selectedAgents, remove, accept);
 }
 
 template<typename T>
 template<typename filterStruct>
 void SharedContext<T>::selectAgents(filterLocalFlag localOrNonLocalOnly, int count, std::vector<T*>& selectedAgents, int type, filterStruct& filter, bool remove, int popSize){
-	if(popSize <= -1) selectNElementsInRandomOrder(byTypeFilteredBegin(localOrNonLocalOnly, type, filter), byTypeFilteredEnd(localOrNonLocalOnly, type, filter), count, selectedAgents, remove);
-	else              selectNElementsInRandomOrder(byTypeFilteredBegin(localOrNonLocalOnly, type, filter), popSize, count, selectedAgents, remove);
+	AgentStateFilter<T>& isLocal = (localOrNonLocalOnly == LOCAL ? LOCAL_FILTER : NON_LOCAL_FILTER);
+	IsAgentType<T> isType(type);
+	BothFilters<T, IsAgentType<T>, filterStruct> typeAndFilter(isType, filter);
+	BothFilters<T, AgentStateFilter<T>, BothFilters<T, IsAgentType<T>, filterStruct> > accept(isLocal, typeAndFilter);
+	this->selectSampledAgents(count, selectedAgents, remove, accept);
 }
 
 
@@ -1047,7 +1062,7 @@ void SharedContext<T>::getAgentStatusInfoExchangePartners(std::set<int>& sends,
 
 
 template<typename T>
-void SharedContext<T>::getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsToKeep, RADIUS radius){
+void SharedContext<T>::getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsToKeep, RADIUS radius){
   typename std::vector<Projection<T> *>::iterator iter    = Context<T>::projections.begin();
   typename std::vector<Projection<T> *>::iterator iterEnd = Context<T>::projections.end();
   while((iter != iterEnd) && (agentsToTest.size() > 0)){
@@ -1057,13 +1072,12 @@ void SharedContext<T>::getRequiredAgents(std::set<AgentId>& agentsToTest, std::s
 }
 
 template<typename T>
-void SharedContext<T>::getNonlocalAgentsToDrop(std::set<AgentId>& agentsToKeep, std::set<AgentId>& agentsToDrop, RADIUS radius){
+void SharedContext<T>::getNonlocalAgentsToDrop(AgentIdSet& agentsToKeep, AgentIdSet& agentsToDrop, RADIUS radius){
   if(agentsToKeep.size() > 0){
     const_state_aware_iterator iter = begin(NON_LOCAL), iterEnd = end(NON_LOCAL);
-    std::set<AgentId>::iterator notFound = agentsToKeep.end();
     while(iter != iterEnd){
-      AgentId id = (*iter)->getId();
-      if(agentsToKeep.find(id) == notFound) agentsToDrop.insert((*iter)->getId());
+      const AgentId& id = (*iter)->getId();
+      if(!agentsToKeep.contains(id)) agentsToDrop.insert(id);
       iter++;
     }
   }
@@ -1078,15 +1092,13 @@ void SharedContext<T>::getNonlocalAgentsToDrop(std::set<AgentId>& agentsToKeep,
 }
 
 template<typename T>
-void SharedContext<T>::getAgentsToPushToOtherProcesses(std::map<int, std::set<AgentId> >& agentsToPush){
-  std::vector<AgentId> tmp;
-  std::set<AgentId> agentsToTest;
+void SharedContext<T>::getAgentsToPushToOtherProcesses(std::map<int, AgentIdSet>& agentsToPush){
+  localAgentsToTest.clear();
   for(const_state_aware_iterator iter = begin(LOCAL), iterEnd = end(LOCAL); iter != iterEnd; ++iter){
-    tmp.push_back((*iter)->getId());
+    localAgentsToTest.insert((*iter)->getId());
   }
-  agentsToTest.insert(tmp.begin(), tmp.end());
   for(typename std::vector<std::string>::iterator iter = getAgentsToPushProjOrder.begin(), iterEnd = getAgentsToPushProjOrder.end(); iter != iterEnd; iter++){
-     Context<T>::getProjection(*iter)->getAgentsToPush(agentsToTest, agentsToPush);
+     Context<T>::getProjection(*iter)->getAgentsToPush(localAgentsToTest, agentsToPush);
   }
 }
 
@@ -41,9 +41,14 @@
 #ifndef SHAREDCONTINUOUSSPACE_H_
 #define SHAREDCONTINUOUSSPACE_H_
 
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
 #include <boost/mpi/communicator.hpp>
 
 #include "SharedBaseGrid.h"
+#include "BinnedMultipleOccupancy.h"
 
 namespace repast {
 
@@ -52,37 +57,141 @@ namespace repast {
  * primarily adds the buffer synchronization appropriate for this
  * type. Default templated typical SharedContinuousSpaces are defined in SharedGrids.
  *
+ * When the CellAccessor is a BinnedMultipleOccupancy, the space can also be
+ * queried for the agents within a box, within a radius or nearest to a
+ * point. The queries see every agent in the space on this process,
+ * including those in the buffer zone, and follow periodic borders.
+ *
  * @see SharedBaseGrid for more details.
  *
  * @tparam T the type of objects contained by this BaseGrid
  * @tparam GPTransformer transforms cell points according to the topology (e.g. periodic)
  * of the BaseGrid.
  * @tparam Adder determines how objects are added to the grid from its associated context.
+ * @tparam CellAccessor implements the storage for the space's locations.
  */
-template<typename T, typename GPTransformer, typename Adder>
-class SharedContinuousSpace: public SharedBaseGrid<T, GPTransformer, Adder, double> {
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor = MultipleOccupancy<T, double> >
+class SharedContinuousSpace: public SharedBaseGrid<T, GPTransformer, Adder, double, CellAccessor> {
 
 protected:
 	virtual void synchMoveTo(const AgentId& id, const Point<double>& pt);
 
 private:
 
-	typedef SharedBaseGrid<T, GPTransformer, Adder, double> SharedBaseGridType;
+	typedef SharedBaseGrid<T, GPTransformer, Adder, double, CellAccessor> SharedBaseGridType;
+
+	struct CollectAgents {
+		std::vector<T*>& out;
+
+		CollectAgents(std::vector<T*>& out) :
+				out(out) {
+		}
+
+		template<typename PointType>
+		void operator()(T* agent, const PointType& location) {
+			out.push_back(agent);
+		}
+	};
+
+	template<std::size_t M>
+	struct CollectWithinRadius {
+		const SharedContinuousSpace& space;
+		const Point<double, M>& center;
+		double radiusSq;
+		std::vector<std::pair<double, T*> >& out;
+
+		CollectWithinRadius(const SharedContinuousSpace& space, const Point<double, M>& center, double radius,
+				std::vector<std::pair<double, T*> >& out) :
+				space(space), center(center), radiusSq(radius * radius), out(out) {
+		}
+
+		template<typename PointType>
+		void operator()(T* agent, const PointType& location) {
+			double distanceSq = space.distanceSq(center, location);
+			if (distanceSq <= radiusSq)
+				out.push_back(std::make_pair(distanceSq, agent));
+		}
+	};
+
+	// orders by distance, then by id so equidistant agents come back in
+	// the same order on every run
+	static bool nearerThan(const std::pair<double, T*>& one, const std::pair<double, T*>& other) {
+		if (one.first != other.first)
+			return one.first < other.first;
+		return one.second->getId() < other.second->getId();
+	}
+
+	template<std::size_t M, typename PointType>
+	double distanceSq(const Point<double, M>& pt1, const PointType& pt2) const;
+
+	template<typename Visitor>
+	void visitBox(const std::vector<double>& lower, const std::vector<double>& upper, Visitor& visit) const;
+
+	template<std::size_t M>
+	void collectWithinRadius(const Point<double, M>& center, double radius,
+			std::vector<std::pair<double, T*> >& out) const;
 
 public:
 	virtual ~SharedContinuousSpace();
 	SharedContinuousSpace(std::string name, GridDimensions gridDims, std::vector<int> processDims, int buffer, boost::mpi::communicator* communicator);
 
+	/**
+	 * Sets the width of the bins the queries search, rebinning the space's
+	 * agents. A width close to the typical query radius works best. Requires
+	 * a BinnedMultipleOccupancy CellAccessor.
+	 *
+	 * @param width the bin width
+	 */
+	void setQueryBinWidth(double width) {
+		SharedBaseGridType::GridBaseType::cellAccessor.setBinWidth(width);
+	}
+
+	/**
+	 * Gets the agents whose locations are within the specified box, bounds
+	 * included. In a periodic space the box may extend across the borders.
+	 * Requires a BinnedMultipleOccupancy CellAccessor.
+	 *
+	 * @param lower the lower corner of the box
+	 * @param upper the upper corner of the box
+	 * @param [out] out the found agents will be appended to this vector
+	 */
+	template<std::size_t M>
+	void queryBox(const Point<double, M>& lower, const Point<double, M>& upper, std::vector<T*>& out) const;
+
+	/**
+	 * Gets the agents within the specified distance of the specified point,
+	 * measured as getDistance does. Requires a BinnedMultipleOccupancy
+	 * CellAccessor.
+	 *
+	 * @param center the point to search around
+	 * @param radius the distance to search within
+	 * @param [out] out the found agents will be appended to this vector
+	 */
+	template<std::size_t M>
+	void queryRadius(const Point<double, M>& center, double radius, std::vector<T*>& out) const;
+
+	/**
+	 * Gets the k agents nearest the specified point, nearest first, measured
+	 * as getDistance does. Fewer are returned if the space holds fewer than
+	 * k agents. Requires a BinnedMultipleOccupancy CellAccessor.
+	 *
+	 * @param center the point to search around
+	 * @param k the number of agents to get
+	 * @param [out] out the found agents will be appended to this vector
+	 */
+	template<std::size_t M>
+	void kNearest(const Point<double, M>& center, size_t k, std::vector<T*>& out) const;
+
 };
 
-template<typename T, typename GPTransformer, typename Adder>
-SharedContinuousSpace<T, GPTransformer, Adder>::SharedContinuousSpace(std::string name, GridDimensions gridDims,
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::SharedContinuousSpace(std::string name, GridDimensions gridDims,
 		std::vector<int> processDims, int buffer, boost::mpi::communicator* communicator) :
-	SharedBaseGrid<T, GPTransformer, Adder, double> (name, gridDims, processDims, buffer, communicator) {
+	SharedBaseGridType(name, gridDims, processDims, buffer, communicator) {
 }
 
-template<typename T, typename GPTransformer, typename Adder>
-void SharedContinuousSpace<T, GPTransformer, Adder>::synchMoveTo(const AgentId& id, const Point<double>& pt) {
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::synchMoveTo(const AgentId& id, const Point<double>& pt) {
 	//unlikely chance that agent could have
 	// moved and then "died" and so removed from sending context, in which case
 	// it would never get sent to this grid.
@@ -91,9 +200,145 @@ void SharedContinuousSpace<T, GPTransformer, Adder>::synchMoveTo(const AgentId&
 	}
 }
 
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+template<std::size_t M, typename PointType>
+double SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::distanceSq(const Point<double, M>& pt1,
+		const PointType& pt2) const {
+	// as BaseGrid::getDistanceSq, without converting the points
+	const GridDimensions& dims = SharedBaseGridType::globalBounds;
+	bool periodic = SharedBaseGridType::GridBaseType::isPeriodic();
+	double sum = 0;
+	for (size_t i = 0, n = pt1.dimensionCount(); i < n; i++) {
+		double diff = pt1[i] - pt2[i];
+		if (periodic) {
+			double absDiff = std::fabs(diff);
+			if (absDiff > dims.extents(i) / 2.0) diff = dims.extents(i) - absDiff;
+		}
+		sum += diff * diff;
+	}
+	return sum;
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+template<typename Visitor>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::visitBox(const std::vector<double>& lower,
+		const std::vector<double>& upper, Visitor& visit) const {
+	const GridDimensions& dims = SharedBaseGridType::globalBounds;
+	size_t dimCount = dims.dimensionCount();
+	if (lower.size() != dimCount || upper.size() != dimCount)
+		throw Repast_Error_63(lower.size() != dimCount ? lower.size() : upper.size(), dimCount); // Query points must match the space's dimensions
+
+	if (!SharedBaseGridType::GridBaseType::isPeriodic()) {
+		SharedBaseGridType::GridBaseType::cellAccessor.visitBox(lower, upper, visit);
+		return;
+	}
+
+	// Agents in a periodic space are held at locations within the global
+	// bounds, so split the box along the borders it crosses and wrap each
+	// piece back inside them. The pieces don't overlap, so no agent is
+	// visited twice.
+	std::vector<std::vector<std::pair<double, double> > > spans(dimCount);
+	for (size_t i = 0; i < dimCount; i++) {
+		double start = dims.origin(i), extent = dims.extents(i);
+		double lo = lower[i], hi = upper[i];
+		if (hi - lo >= extent) {
+			spans[i].push_back(std::make_pair(start, start + extent));
+		} else {
+			double shift = std::floor((lo - start) / extent) * extent;
+			lo -= shift;
+			hi -= shift;
+			if (hi < start + extent) {
+				spans[i].push_back(std::make_pair(lo, hi));
+			} else {
+				spans[i].push_back(std::make_pair(lo, start + extent));
+				spans[i].push_back(std::make_pair(start, hi - extent));
+			}
+		}
+	}
+
+	std::vector<size_t> piece(dimCount, 0);
+	std::vector<double> pieceLower(dimCount), pieceUpper(dimCount);
+	while (true) {
+		for (size_t i = 0; i < dimCount; i++) {
+			pieceLower[i] = spans[i][piece[i]].first;
+			pieceUpper[i] = spans[i][piece[i]].second;
+		}
+		SharedBaseGridType::GridBaseType::cellAccessor.visitBox(pieceLower, pieceUpper, visit);
+
+		size_t i = 0;
+		while (i < dimCount && ++piece[i] == spans[i].size()) {
+			piece[i] = 0;
+			i++;
+		}
+		if (i == dimCount)
+			break;
+	}
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+template<std::size_t M>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::queryBox(const Point<double, M>& lower,
+		const Point<double, M>& upper, std::vector<T*>& out) const {
+	CollectAgents collect(out);
+	visitBox(std::vector<double>(lower.begin(), lower.end()), std::vector<double>(upper.begin(), upper.end()), collect);
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+template<std::size_t M>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::collectWithinRadius(const Point<double, M>& center,
+		double radius, std::vector<std::pair<double, T*> >& out) const {
+	std::vector<double> lower(center.begin(), center.end()), upper(lower);
+	for (size_t i = 0; i < lower.size(); i++) {
+		lower[i] -= radius;
+		upper[i] += radius;
+	}
+	CollectWithinRadius<M> collect(*this, center, radius, out);
+	visitBox(lower, upper, collect);
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+template<std::size_t M>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::queryRadius(const Point<double, M>& center,
+		double radius, std::vector<T*>& out) const {
+	std::vector<std::pair<double, T*> > found;
+	collectWithinRadius(center, radius, found);
+	for (size_t i = 0; i < found.size(); i++)
+		out.push_back(found[i].second);
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+template<std::size_t M>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::kNearest(const Point<double, M>& center, size_t k,
+		std::vector<T*>& out) const {
+	if (k == 0)
+		return;
+
+	// widen the search until it holds k agents; those are then certain to
+	// include the k nearest. Past the span of the space it holds them all.
+	const GridDimensions& dims = SharedBaseGridType::globalBounds;
+	double span = 0;
+	for (size_t i = 0; i < dims.dimensionCount(); i++)
+		span += dims.extents(i) * dims.extents(i);
+	span = std::sqrt(span);
+
+	std::vector<std::pair<double, T*> > found;
+	double radius = SharedBaseGridType::GridBaseType::cellAccessor.binWidth();
+	while (true) {
+		found.clear();
+		collectWithinRadius(center, radius, found);
+		if (found.size() >= k || radius > span)
+			break;
+		radius *= 2;
+	}
+
+	size_t count = std::min(k, found.size());
+	std::partial_sort(found.begin(), found.begin() + count, found.end(), nearerThan);
+	for (size_t i = 0; i < count; i++)
+		out.push_back(found[i].second);
+}
 
-template<typename T, typename GPTransformer, typename Adder>
-SharedContinuousSpace<T, GPTransformer, Adder>::~SharedContinuousSpace() {
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::~SharedContinuousSpace() {
 }
 
 }
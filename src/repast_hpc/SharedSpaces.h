@@ -66,6 +66,22 @@ struct SharedSpaces {
 	 */
 	typedef SharedDiscreteSpace<T, StrictBorders, SimpleAdder<T> > SharedStrictDiscreteSpace;
 
+	/**
+	 * Two dimensional discrete grid space with periodic (toroidal) borders whose local cells
+	 * are held in a flat array (see DenseMultipleOccupancy). Suits dense worlds.
+	 * Any added agents are not given a location, but are in "grid limbo" until
+	 * moved via a grid move call.
+	 */
+	typedef SharedDiscreteSpace<T, WrapAroundBorders, SimpleAdder<T>, DenseMultipleOccupancy<T, int, 2> > SharedWrappedDenseDiscreteSpace;
+
+	/**
+	 * Two dimensional discrete grid space with strict borders whose local cells are held in a
+	 * flat array (see DenseMultipleOccupancy). Suits dense worlds. Any added
+	 * agents are not given a location, but are in "grid limbo" until moved via
+	 * a grid move call.
+	 */
+	typedef SharedDiscreteSpace<T, StrictBorders, SimpleAdder<T>, DenseMultipleOccupancy<T, int, 2> > SharedStrictDenseDiscreteSpace;
+
 	/**
 	 * Continuous space with periodic (toroidal) borders. Any added
 	 * agents are not given a location, but are in "grid limbo" until
@@ -79,6 +95,22 @@ struct SharedSpaces {
 	 * moved via a grid move call.
 	 */
 	typedef SharedContinuousSpace<T, StrictBorders, SimpleAdder<T> > SharedStrictContinuousSpace;
+
+	/**
+	 * Two dimensional continuous space with periodic (toroidal) borders whose agents are
+	 * binned (see BinnedMultipleOccupancy), so it supports queryBox, queryRadius and
+	 * kNearest. Any added agents are not given a location, but are in "grid limbo" until
+	 * moved via a grid move call.
+	 */
+	typedef SharedContinuousSpace<T, WrapAroundBorders, SimpleAdder<T>, BinnedMultipleOccupancy<T, double, 2> > SharedWrappedIndexedContinuousSpace;
+
+	/**
+	 * Two dimensional continuous space with strict borders whose agents are binned
+	 * (see BinnedMultipleOccupancy), so it supports queryBox, queryRadius and kNearest.
+	 * Any added agents are not given a location, but are in "grid limbo" until moved
+	 * via a grid move call.
+	 */
+	typedef SharedContinuousSpace<T, StrictBorders, SimpleAdder<T>, BinnedMultipleOccupancy<T, double, 2> > SharedStrictIndexedContinuousSpace;
 };
 
 }
@@ -45,6 +45,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include "Point.h"
+#include "GridDimensions.h"
 
 namespace repast {
 
@@ -55,12 +56,22 @@ namespace repast {
  * @param T the type of object in the Grid
  * @param GPType the coordinate type of the grid point locations. This must
  * be an int or a double.
+ * @param N the dimension count of the Point<GPType, N> locations are keyed
+ * on, or 0 for the dynamically sized Point<GPType>. Lookups accept either kind
+ * of point whatever N is.
  */
-template<typename T, typename GPType>
+template<typename T, typename GPType, std::size_t N = 0>
 class SingleOccupancy {
 
+public:
+
+	/**
+	 * The type of point locations are keyed on.
+	 */
+	typedef Point<GPType, N> PointType;
+
 private:
-	typedef typename boost::unordered_map<Point<GPType> , boost::shared_ptr<T>, HashGridPoint<GPType> > LocationMap;
+	typedef typename boost::unordered_map<PointType, boost::shared_ptr<T>, HashGridPoint<GPType, N> > LocationMap;
 	typedef typename LocationMap::iterator LocationMapIter;
 	typedef typename LocationMap::const_iterator LocationMapConstIter;
 
@@ -68,6 +79,12 @@ private:
 
 public:
 
+	/**
+	 * Locations are held in an unbounded map, so there is nothing to size.
+	 */
+	void init(const GridDimensions& bounds) {
+	}
+
 	/**
 	 * Gets the object found at the specified location.
 	 *
@@ -75,7 +92,8 @@ public:
 	 * @return the first object found at the specified location or 0 if there
 	 * are no objects at the specified location.
 	 */
-	T* get(const Point<GPType>& location) const;
+	template<std::size_t M>
+	T* get(const Point<GPType, M>& location) const;
 
 	/**
 	 * Gets the item found at the specified location.
@@ -83,7 +101,8 @@ public:
 	 * @param location the location to get the item at
 	 * @param [out] the found item will be returned in this vector
 	 */
-	void getAll(const Point<GPType>& location, std::vector<T*>& out) const;
+	template<std::size_t M>
+	void getAll(const Point<GPType, M>& location, std::vector<T*>& out) const;
 
 	/**
 	 * Puts the specified item at the specified location.
@@ -91,7 +110,8 @@ public:
 	 * @param agent the item to put
 	 * @param location the location to put the item at
 	 */
-	bool put(boost::shared_ptr<T>& agent, const Point<GPType>& location);
+	template<std::size_t M>
+	bool put(boost::shared_ptr<T>& agent, const Point<GPType, M>& location);
 
 	/**
 	 * Removes the specified item from the specified location.
@@ -99,39 +119,46 @@ public:
 	 * @param agent the item to remove
 	 * @param location the location to remove the item from
 	 */
-	void remove(boost::shared_ptr<T>& agent, const Point<GPType>& location);
+	template<std::size_t M>
+	void remove(boost::shared_ptr<T>& agent, const Point<GPType, M>& location);
 
 };
 
-template<typename T, typename GPType>
-T* SingleOccupancy<T, GPType>::get(const Point<GPType>& location) const {
-	LocationMapConstIter iter = locations.find(location);
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+T* SingleOccupancy<T, GPType, N>::get(const Point<GPType, M>& location) const {
+	LocationMapConstIter iter = locations.find(location, HashGridPoint<GPType, M>(), EqualGridPoint());
 	if (iter == locations.end())
 		return NULL;
 	return iter->second.get();
 }
 
-template<typename T, typename GPType>
-void SingleOccupancy<T, GPType>::getAll(const Point<GPType>& location, std::vector<T*>& out) const {
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+void SingleOccupancy<T, GPType, N>::getAll(const Point<GPType, M>& location, std::vector<T*>& out) const {
 	T* agent = get(location);
 	if (agent != NULL) {
 		out.push_back(agent);
 	}
 }
 
-template<typename T, typename GPType>
-bool SingleOccupancy<T, GPType>::put(boost::shared_ptr<T>& agent, const Point<GPType>& location) {
-	LocationMapIter iter = locations.find(location);
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+bool SingleOccupancy<T, GPType, N>::put(boost::shared_ptr<T>& agent, const Point<GPType, M>& location) {
+	LocationMapIter iter = locations.find(location, HashGridPoint<GPType, M>(), EqualGridPoint());
 	// already occupied
 	if (iter != locations.end())
 		return false;
-	locations[location] = agent;
+	locations[PointType(location)] = agent;
 	return true;
 }
 
-template<typename T, typename GPType>
-void SingleOccupancy<T, GPType>::remove(boost::shared_ptr<T>& agent, const Point<GPType>& location) {
-	locations.erase(location);
+template<typename T, typename GPType, std::size_t N>
+template<std::size_t M>
+void SingleOccupancy<T, GPType, N>::remove(boost::shared_ptr<T>& agent, const Point<GPType, M>& location) {
+	LocationMapIter iter = locations.find(location, HashGridPoint<GPType, M>(), EqualGridPoint());
+	if (iter != locations.end())
+		locations.erase(iter);
 }
 
 }
@@ -66,6 +66,13 @@ struct Spaces {
 	typedef BaseGrid<T, MultipleOccupancy<T, double>, StrictBorders,     SimpleAdder<T> , double> MultipleStrictContinuousSpace;
 	typedef BaseGrid<T, MultipleOccupancy<T, double>, WrapAroundBorders, SimpleAdder<T> , double> MultipleWrappedContinuousSpace;
 
+	// two dimensional spaces keyed on Point<GPType, 2>; moves and lookups made
+	// with Point<GPType, 2> do not allocate points.
+	typedef BaseGrid<T, MultipleOccupancy<T, int, 2>,    StrictBorders,     SimpleAdder<T> , int>    MultipleStrictDiscreteSpace2D;
+	typedef BaseGrid<T, MultipleOccupancy<T, int, 2>,    WrapAroundBorders, SimpleAdder<T> , int>    MultipleWrappedDiscreteSpace2D;
+	typedef BaseGrid<T, MultipleOccupancy<T, double, 2>, StrictBorders,     SimpleAdder<T> , double> MultipleStrictContinuousSpace2D;
+	typedef BaseGrid<T, MultipleOccupancy<T, double, 2>, WrapAroundBorders, SimpleAdder<T> , double> MultipleWrappedContinuousSpace2D;
+
 };
 
 }
@@ -89,7 +89,7 @@ void VN2DGridQuery<T>::query(const Point<int>& center, int range, bool includeCe
 
 	int yMax = center[1];
 	for (int y = yMin; y < yMax; y++) {
-		Grid2DQuery<T>::_grid->getObjectsAt(Point<int> (center[0], y), out);
+		Grid2DQuery<T>::_grid->getObjectsAt(Point<int, 2> (center[0], y), out);
 	}
 
 	yMax = center[1] + range + 1;
@@ -98,14 +98,14 @@ void VN2DGridQuery<T>::query(const Point<int>& center, int range, bool includeCe
 	// skip the center
 	yMin = center[1] + 1;
 	for (int y = yMin; y < yMax; y++) {
-		Grid2DQuery<T>::_grid->getObjectsAt(Point<int> (center[0], y), out);
+		Grid2DQuery<T>::_grid->getObjectsAt(Point<int, 2> (center[0], y), out);
 	}
 
 	int xMin = center[0] - range;
 	if (!Grid2DQuery<T>::_grid->isPeriodic() && xMin < Grid2DQuery<T>::minMax[0][0])
 		xMin = Grid2DQuery<T>::minMax[0][0];
 	for (int x = xMin; x < center[0]; x++) {
-		Grid2DQuery<T>::_grid->getObjectsAt(Point<int> (x, center[1]), out);
+		Grid2DQuery<T>::_grid->getObjectsAt(Point<int, 2> (x, center[1]), out);
 	}
 
 	int xMax = center[0] + range + 1;
@@ -113,7 +113,7 @@ void VN2DGridQuery<T>::query(const Point<int>& center, int range, bool includeCe
 		xMax = Grid2DQuery<T>::minMax[0][1];
 	xMin = center[0] + 1;
 	for (int x = xMin; x < xMax; x++) {
-		Grid2DQuery<T>::_grid->getObjectsAt(Point<int> (x, center[1]), out);
+		Grid2DQuery<T>::_grid->getObjectsAt(Point<int, 2> (x, center[1]), out);
 	}
 }
 
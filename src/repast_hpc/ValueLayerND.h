@@ -48,6 +48,7 @@
 #include "Point.h"
 #include "GridDimensions.h"
 #include "RepastProcess.h"
+#include "initialize_threads.h"
 
 
 using namespace std;
@@ -56,7 +57,8 @@ namespace repast {
 
 /**
  * The RankDatum struct stores the data that the ValueLayerND
- * class will need for each of its 3^N - 1 neighboring ranks.
+ * class will need for each of its 3^N - 1 neighboring ranks
+ * (or, for a dimension-ordered exchange, for each of its 2N faces).
  * N.B.: We could use a map from rank to the rest of the data, but
  * we will rarely need to index it that way, and instead can just
  * loop through it
@@ -252,6 +254,26 @@ bool DimensionDatum<T>::isInLocalBounds(int originalCoord){
 template<typename T>
 class AbstractValueLayerND{
 
+public:
+
+  /**
+   * Strategies for exchanging buffer zones with adjacent processes.
+   *
+   * ALL_NEIGHBORS sends one message to each of the 3^N - 1 adjacent
+   * processes, all at once.
+   *
+   * DIMENSION_ORDERED exchanges only the 2N faces, one dimension at a
+   * time: the faces sent along dimension d include the buffer zones
+   * received along dimensions 0 to d - 1, so edge and corner values
+   * are forwarded through the face neighbors. This sends 2N messages
+   * instead of 3^N - 1 (4 instead of 8 in 2D, 6 instead of 26 in 3D),
+   * at the cost of N rounds that must complete one after the other.
+   * Where a non-periodic global boundary means a corner process does
+   * not exist, the corner receives the face neighbor's buffer zone
+   * values rather than being left unchanged.
+   */
+  enum Exchange { ALL_NEIGHBORS, DIMENSION_ORDERED };
+
 private:
   bool dummy; // Used for cases when error flag is not requested
 
@@ -268,10 +290,18 @@ protected:
   vector<DimensionDatum<T> > dimensionData;          // List of data for each dimension
   RankDatum*                 neighborData;           // List of data for each adjacent rank
   int                        neighborCount;          // Count of adjacent ranks
-  MPI_Request*               requests;               // Pointer to MPI requests (for wait operations)
+  int                        directionCount;         // Count of directions in N-space (3^N), used to form tags
+
+  Exchange                   exchange;               // Strategy used to synchronize the buffer zones
+  RankDatum*                 faceData;               // List of data for each face (2N, dimension-ordered exchange only)
+  RankDatum*                 exchangeData;           // neighborData or faceData, grouped by round
+  int                        roundCount;             // Count of rounds that must complete one after the other
+  int                        roundSize;              // Count of partners (sends and receives) in each round
+  int                        syncRequestCount;       // Count of requests in one set of synchronization requests
+  MPI_Request*               requests;               // Persistent requests of the exchange in progress, or 0 (for wait operations)
+  int                        round;                  // Round of the exchange in progress
 
   int                        instanceID;             // Unique ID for managing MPI requests without mix-ups
-  int                        syncCount;
 
   /**
    * Constructor
@@ -280,8 +310,10 @@ protected:
    * @param globalBoundaries global boundaries for the simulation
    * @param bufferSize size of the buffer zone
    * @param periodic true if the space is periodic, false otherwise
+   * @param exchangeStrategy strategy used to synchronize the buffer zones
    */
-  AbstractValueLayerND(vector<int> processesPerDim, GridDimensions globalBoundaries, int bufferSize, bool periodic);
+  AbstractValueLayerND(vector<int> processesPerDim, GridDimensions globalBoundaries, int bufferSize, bool periodic,
+      Exchange exchangeStrategy = ALL_NEIGHBORS);
   virtual ~AbstractValueLayerND();
 
 
@@ -315,6 +347,53 @@ public:
     return localBoundaries;
   }
 
+  /**
+   * Gets the strategy used to synchronize the buffer zones
+   *
+   * @return the exchange strategy
+   */
+  Exchange getExchange(){
+    return exchange;
+  }
+
+  /**
+   * Gets the number of messages this process sends (and receives)
+   * during one synchronization, including messages to MPI_PROC_NULL
+   * at non-periodic global boundaries
+   *
+   * @return the number of messages sent per synchronization
+   */
+  int getSynchronizeMessageCount(){
+    return roundCount * roundSize;
+  }
+
+  /**
+   * Synchronizes across processes. This copies
+   * the values in the interior 'buffer zones' from
+   * self and sends to adjacent processes, while
+   * receiving data from adjacent processes and
+   * placing it in the appropriate exterior buffer
+   * zones. Equivalent to beginSynchronize followed by
+   * endSynchronize.
+   */
+  virtual void synchronize();
+
+  /**
+   * Starts synchronizing across processes (see synchronize) without
+   * waiting for the exchange to finish. While the exchange is in progress
+   * local cells may be read but not written, and buffer zone cells may be
+   * neither read nor written; a model can use this time to work on
+   * cells further than the buffer width from the local boundaries.
+   * Every call must be matched by a call to endSynchronize.
+   */
+  virtual void beginSynchronize() = 0;
+
+  /**
+   * Waits for the exchange started by beginSynchronize to finish. On return
+   * the buffer zones hold the values sent by adjacent processes.
+   */
+  virtual void endSynchronize();
+
 protected:
   // Methods implemented in this class but visible only to child classes:
 
@@ -359,6 +438,34 @@ protected:
    */
   int getIndex(Point<int> location);
 
+  /**
+   * Creates the persistent send and receive requests that synchronize the
+   * given data space with adjacent processes. The requests are bound to the
+   * data space's address, so a data space needs its own set; each set holds
+   * syncRequestCount requests, grouped by round (in each round the sends
+   * come first, then the receives).
+   *
+   * @param dataSpace the data space to be synchronized
+   * @param syncRequests array into which the requests will be placed
+   */
+  void initSynchronizeRequests(T* dataSpace, MPI_Request* syncRequests);
+
+  /**
+   * Starts the first round of the given set of persistent requests;
+   * endSynchronize will wait for it and run any later rounds.
+   *
+   * @param syncRequests a set of requests created by initSynchronizeRequests
+   */
+  void startSynchronizeRequests(MPI_Request* syncRequests);
+
+  /**
+   * Frees the given set of persistent requests. Does nothing if MPI
+   * has already been finalized.
+   *
+   * @param syncRequests a set of requests created by initSynchronizeRequests
+   */
+  void freeSynchronizeRequests(MPI_Request* syncRequests);
+
 
   // Virtual methods (implemented by child classes
 
@@ -464,16 +571,6 @@ protected:
    */
   virtual T getValueAt(vector<int> location, bool& errFlag) = 0;
 
-  /**
-   * Synchronizes across processes. This copies
-   * the values in the interior 'buffer zones' from
-   * self and sends to adjacent processes, while
-   * receiving data from adjacent processes and
-   * placing it in the appropriate exterior buffer
-   * zones.
-   */
-  virtual void synchronize() = 0;
-
 private:
 
   /**
@@ -490,6 +587,20 @@ private:
    */
   void getMPIDataType(RelativeLocation relLoc, MPI_Datatype &datatype);
 
+  /**
+   * Fills in the data for the face exchanged with the adjacent process
+   * on one side of one dimension during a dimension-ordered exchange.
+   * The face is a buffer-width slab that spans the full width (buffer
+   * zones included) of the lower dimensions and the local width of the
+   * higher dimensions.
+   *
+   * @param datum the datum to be filled in
+   * @param dimIndex index of the dimension
+   * @param side -1 for the left face, 1 for the right
+   * @param myCoordinates this process's coordinates in the topology
+   */
+  void getFaceDatum(RankDatum& datum, int dimIndex, int side, vector<int>& myCoordinates);
+
   /**
    * A variant of the getMPIDataType function, this
    * one assumes that you are retrieving a block with side
@@ -559,7 +670,8 @@ template<typename T>
 int AbstractValueLayerND<T>::instanceCount = 0;
 
 template<typename T>
-AbstractValueLayerND<T>::AbstractValueLayerND(vector<int> processesPerDim, GridDimensions globalBoundaries,int bufferSize, bool periodic): globalSpaceIsPeriodic(periodic), syncCount(0){
+AbstractValueLayerND<T>::AbstractValueLayerND(vector<int> processesPerDim, GridDimensions globalBoundaries,int bufferSize, bool periodic,
+    Exchange exchangeStrategy): globalSpaceIsPeriodic(periodic), exchange(exchangeStrategy), faceData(0), requests(0), round(0){
   instanceID = AbstractValueLayerND<T>::instanceCount;
   AbstractValueLayerND<T>::instanceCount++;
   cartTopology = RepastProcess::instance()->getCartesianTopology(processesPerDim, periodic);
@@ -588,7 +700,8 @@ AbstractValueLayerND<T>::AbstractValueLayerND(vector<int> processesPerDim, GridD
   vector<int> myCoordinates;
   cartTopology->getCoordinates(rank, myCoordinates);
 
-  neighborData = new RankDatum[relLoc.getMaxIndex()];
+  directionCount = relLoc.getTotalValues();
+  neighborData = new RankDatum[directionCount - 1];
   neighborCount = 0;
   do{
     if(relLoc.validNonCenter()){ // Skip 0,0,0,0,0
@@ -607,14 +720,115 @@ AbstractValueLayerND<T>::AbstractValueLayerND(vector<int> processesPerDim, GridD
     }
   }while(relLoc.increment());
 
-  // Create arrays for MPI requests and results (statuses)
-  requests = new MPI_Request[neighborCount * 2];
+  // The neighbor data is kept for flowback even when the faces are exchanged instead
+  if(exchange == DIMENSION_ORDERED){
+    faceData = new RankDatum[2 * numDims];
+    for(int i = 0; i < numDims; i++){
+      getFaceDatum(faceData[2 * i],     i, -1, myCoordinates);
+      getFaceDatum(faceData[2 * i + 1], i,  1, myCoordinates);
+    }
+    exchangeData = faceData;
+    roundCount   = numDims;
+    roundSize    = 2;
+  }
+  else{
+    exchangeData = neighborData;
+    roundCount   = 1;
+    roundSize    = neighborCount;
+  }
+  syncRequestCount = roundCount * roundSize * 2;
 }
 
 template<typename T>
 AbstractValueLayerND<T>::~AbstractValueLayerND(){
   delete[] neighborData; // Should Free MPI Datatypes first...
-  delete[] requests;
+  delete[] faceData;
+}
+
+template<typename T>
+void AbstractValueLayerND<T>::getFaceDatum(RankDatum& datum, int dimIndex, int side, vector<int>& myCoordinates){
+  vector<int> sideLengths;
+  int sendOffset = 0;
+  int receiveOffset = 0;
+  for(int i = 0; i < numDims; i++){
+    DimensionDatum<T>* dim = &dimensionData[i];
+    if(i < dimIndex){       // Full width, including the buffer zones received in earlier rounds
+      sideLengths.push_back(dim->width);
+    }
+    else if(i == dimIndex){ // The buffer width on the side being exchanged
+      sideLengths.push_back(dim->getSendReceiveSize(side));
+      sendOffset    += (side < 0 ? dim->leftBufferSize : dim->width - (2 * dim->rightBufferSize)) * places[i];
+      receiveOffset += (side < 0 ? 0                   : dim->width - dim->rightBufferSize)       * places[i];
+    }
+    else{                   // Local cells only
+      sideLengths.push_back(dim->localWidth);
+      sendOffset    += dim->leftBufferSize * places[i];
+      receiveOffset += dim->leftBufferSize * places[i];
+    }
+  }
+  getMPIDataType(sideLengths, datum.datatype, numDims - 1);
+  datum.sendPtrOffset    = sendOffset;
+  datum.receivePtrOffset = receiveOffset;
+
+  vector<int> direction;
+  direction.assign(numDims, 0);
+  direction[dimIndex] = side;
+  datum.rank    = cartTopology->getRank(myCoordinates, direction);
+  datum.sendDir = RelativeLocation::getDirectionIndex(direction);
+  datum.recvDir = RelativeLocation::getReverseDirectionIndex(direction);
+}
+
+template<typename T>
+void AbstractValueLayerND<T>::initSynchronizeRequests(T* dataSpace, MPI_Request* syncRequests){
+  // Note: the tag must differentiate between sends and receives that are going to the same rank.
+  // If a dimension has only 2 processes but wrap-around borders, then one process may be sending
+  // to the other process twice (once left and once right). The 'sendDir' and 'recvDir' values trap
+  // this. Successive exchanges can share tags because a persistent receive is not restarted
+  // until the previous one has completed, and messages between a pair of ranks do not overtake.
+  for(int r = 0; r < roundCount; r++){
+    RankDatum*   roundData     = &exchangeData[r * roundSize];
+    MPI_Request* roundRequests = &syncRequests[r * roundSize * 2];
+    for(int i = 0; i < roundSize; i++){
+      MPI_Send_init(&dataSpace[roundData[i].sendPtrOffset], 1, roundData[i].datatype,
+          roundData[i].rank, instanceID * directionCount + roundData[i].sendDir, cartTopology->topologyComm, &roundRequests[i]);
+      MPI_Recv_init(&dataSpace[roundData[i].receivePtrOffset], 1, roundData[i].datatype,
+          roundData[i].rank, instanceID * directionCount + roundData[i].recvDir, cartTopology->topologyComm, &roundRequests[roundSize + i]);
+    }
+  }
+}
+
+template<typename T>
+void AbstractValueLayerND<T>::startSynchronizeRequests(MPI_Request* syncRequests){
+  requests = syncRequests;
+  round = 0;
+  MPI_Startall(roundSize * 2, requests);
+}
+
+template<typename T>
+void AbstractValueLayerND<T>::freeSynchronizeRequests(MPI_Request* syncRequests){
+  int finalized;
+  MPI_Finalized(&finalized);
+  if(finalized) return;
+  for(int i = 0; i < syncRequestCount; i++) MPI_Request_free(&syncRequests[i]);
+}
+
+template<typename T>
+void AbstractValueLayerND<T>::endSynchronize(){
+  if(requests == 0) return;
+  // Each round sends values received in the rounds before it, so rounds cannot overlap
+  while(true){
+    MPI_Waitall(roundSize * 2, &requests[round * roundSize * 2], MPI_STATUSES_IGNORE);
+    round++;
+    if(round == roundCount) break;
+    MPI_Startall(roundSize * 2, &requests[round * roundSize * 2]);
+  }
+  requests = 0;
+}
+
+template<typename T>
+void AbstractValueLayerND<T>::synchronize(){
+  beginSynchronize();
+  endSynchronize();
 }
 
 template<typename T>
@@ -740,7 +954,11 @@ int AbstractValueLayerND<T>::getReceivePointerOffset(RelativeLocation relLoc){
  *
  * In this class, an MPI Datatype is defined to represent
  * the volume of space being sent to and received from
- * each of the 3N - 1 adjacent processes.
+ * each of the 3N - 1 adjacent processes. (If the layer is
+ * constructed with the DIMENSION_ORDERED exchange, a datatype
+ * is instead defined for each of the 2N faces, and the faces
+ * are exchanged one dimension at a time; see
+ * AbstractValueLayerND::Exchange.)
  *
  * One important note is that the send and receive data types
  * for a given exchange partner will be identical; only the
@@ -769,13 +987,17 @@ int AbstractValueLayerND<T>::getReceivePointerOffset(RelativeLocation relLoc){
 template<typename T>
 class ValueLayerND: public AbstractValueLayerND<T>{
 
-private:
+protected:
   T* dataSpace;              // Pointer to the data space
 
+private:
+  MPI_Request* syncRequests; // Persistent requests that synchronize the data space
+
 public:
 
   ValueLayerND(vector<int> processesPerDim, GridDimensions globalBoundaries, int bufferSize,
-      bool periodic, T initialValue = 0, T initialBufferZoneValue = 0);
+      bool periodic, T initialValue = 0, T initialBufferZoneValue = 0,
+      typename AbstractValueLayerND<T>::Exchange exchangeStrategy = AbstractValueLayerND<T>::ALL_NEIGHBORS);
   virtual ~ValueLayerND();
 
   /**
@@ -821,7 +1043,7 @@ public:
   /**
    * Inherited from AbstractValueLayerND
    */
-  virtual void synchronize();
+  virtual void beginSynchronize();
 
   /**
    * Write the values in this ValueLayer to a .csv file.
@@ -897,10 +1119,13 @@ protected:
   T*                dataSpace2;             // Permanent pointer to bank 2 of the data space
   T*                currentDataSpace;       // Temporary pointer to the active data space
   T*                otherDataSpace;         // Temporary pointer to the inactive data space
+  MPI_Request*      syncRequests1;          // Persistent requests that synchronize bank 1
+  MPI_Request*      syncRequests2;          // Persistent requests that synchronize bank 2
 
 public:
 
-  ValueLayerNDSU(vector<int> processesPerDim, GridDimensions globalBoundaries, int bufferSize, bool periodic, T initialValue = 0, T initialBufferZoneValue = 0);
+  ValueLayerNDSU(vector<int> processesPerDim, GridDimensions globalBoundaries, int bufferSize, bool periodic, T initialValue = 0, T initialBufferZoneValue = 0,
+      typename AbstractValueLayerND<T>::Exchange exchangeStrategy = AbstractValueLayerND<T>::ALL_NEIGHBORS);
   virtual ~ValueLayerNDSU();
 
   /**
@@ -944,9 +1169,11 @@ public:
   virtual T getValueAt(vector<int> location, bool& errFlag);
 
   /**
-   * Inherited from AbstractValueLayerND
+   * Inherited from AbstractValueLayerND. Synchronizes the current
+   * data bank; the banks must not be switched until endSynchronize
+   * has been called.
    */
-  virtual void synchronize();
+  virtual void beginSynchronize();
 
   /**
    * Write this rank's data to a CSV file
@@ -1071,6 +1298,11 @@ public:
 
 private:
 
+  /**
+   * Copies one complete data space to the other, split across threads.
+   */
+  void copyDataSpace(T* destination, T* source);
+
   /**
    * Fills a dimension of space with the given value. Used for initialization
    * and clearing only.
@@ -1109,21 +1341,29 @@ private:
 
 template<typename T>
 ValueLayerND<T>::ValueLayerND(vector<int> processesPerDim, GridDimensions globalBoundaries, int bufferSize, bool periodic,
-    T initialValue, T initialBufferZoneValue): AbstractValueLayerND<T>(processesPerDim, globalBoundaries, bufferSize, periodic){
+    T initialValue, T initialBufferZoneValue, typename AbstractValueLayerND<T>::Exchange exchangeStrategy):
+    AbstractValueLayerND<T>(processesPerDim, globalBoundaries, bufferSize, periodic, exchangeStrategy){
 
   // Create the actual arrays for the data
   dataSpace = new T[AbstractValueLayerND<T>::length];
 
+  // Create the requests that will synchronize it
+  syncRequests = new MPI_Request[AbstractValueLayerND<T>::syncRequestCount];
+  this->initSynchronizeRequests(dataSpace, syncRequests);
+
   // Finally, fill the data with the initial values
   initialize(initialValue, initialBufferZoneValue);
 
   // And synchronize
-  synchronize();
+  this->synchronize();
 
 }
 
 template<typename T>
 ValueLayerND<T>::~ValueLayerND(){
+  this->endSynchronize();
+  this->freeSynchronizeRequests(syncRequests);
+  delete[] syncRequests;
   delete[] dataSpace;
 }
 
@@ -1209,27 +1449,8 @@ T ValueLayerND<T>::getValueAt(Point<int> location, bool& errFlag){
 }
 
 template<typename T>
-void ValueLayerND<T>::synchronize(){
-  AbstractValueLayerND<T>::syncCount++;
-  if(AbstractValueLayerND<T>::syncCount > 9) AbstractValueLayerND<T>::syncCount = 0;
-  int mpiTag = AbstractValueLayerND<T>::instanceID * 10 + AbstractValueLayerND<T>::syncCount;
-  // Note: the syncCount and send/recv directions are used to create a unique tag value for the
-  // mpi sends and receives. The tag value must be unique in two ways: first, successive calls to this
-  // function must be different enough that they can't be confused. The 'syncCount' value is used to
-  // achieve this, and it will loop from 0-9 and then repeat. The second, the tag must sometimes
-  // differentiate between sends and receives that are going to the same rank. If a dimension
-  // has only 2 processes but wrap-around borders, then one process may be sending to the other
-  // process twice (once left and once right). The 'sendDir' and 'recvDir' values trap this
-
-  // For each entry in neighbors:
-  MPI_Status statuses[AbstractValueLayerND<T>::neighborCount * 2];
-  for(int i = 0; i < AbstractValueLayerND<T>::neighborCount; i++){
-    MPI_Isend(&dataSpace[AbstractValueLayerND<T>::neighborData[i].sendPtrOffset], 1, AbstractValueLayerND<T>::neighborData[i].datatype,
-        AbstractValueLayerND<T>::neighborData[i].rank, 10 * (AbstractValueLayerND<T>::neighborData[i].sendDir + 1) + mpiTag, AbstractValueLayerND<T>::cartTopology->topologyComm, &AbstractValueLayerND<T>::requests[i]);
-    MPI_Irecv(&dataSpace[AbstractValueLayerND<T>::neighborData[i].receivePtrOffset], 1, AbstractValueLayerND<T>::neighborData[i].datatype,
-        AbstractValueLayerND<T>::neighborData[i].rank, 10 * (AbstractValueLayerND<T>::neighborData[i].recvDir + 1) + mpiTag, AbstractValueLayerND<T>::cartTopology->topologyComm, &AbstractValueLayerND<T>::requests[AbstractValueLayerND<T>::neighborCount + i]);
-  }
-  MPI_Waitall(AbstractValueLayerND<T>::neighborCount * 2, AbstractValueLayerND<T>::requests, statuses);
+void ValueLayerND<T>::beginSynchronize(){
+  this->startSynchronizeRequests(syncRequests);
 }
 
 
@@ -1266,44 +1487,20 @@ void ValueLayerND<T>::fillDimension(T localValue, T bufferValue, bool doBufferZo
 
   int pointerIncrement = AbstractValueLayerND<T>::places[dimIndex];
 
-
-  int i = 0;
-  for(; i < bufferEdge; i++){
-    if(doBufferZone){
-      if(dimIndex == 0){
-        *dataSpacePointer = bufferValue;
-      }
-      else{
-        fillDimension(bufferValue, bufferValue, doBufferZone, doLocal, dataSpacePointer, dimIndex - 1);
-      }
-    }
-    // Increment the pointers
-    dataSpacePointer += pointerIncrement;
-  }
-  for(; i < localEdge; i++){
-    if(doLocal){
-      if(dimIndex == 0){
-        *dataSpacePointer = localValue;
-      }
-      else{
-        fillDimension(localValue, bufferValue, doBufferZone, doLocal, dataSpacePointer, dimIndex - 1);
-      }
+  // The outermost dimension is split across threads
+  int threads = (dimIndex == AbstractValueLayerND<T>::numDims - 1 ? getThreadCount() : 1);
+#pragma omp parallel for num_threads(threads) if(threads > 1)
+  for(int i = 0; i < upperBound; i++){
+    bool local = (i >= bufferEdge && i < localEdge);
+    if(local ? !doLocal : !doBufferZone) continue;
+    T* slicePointer = dataSpacePointer + i * pointerIncrement;
+    if(dimIndex == 0){
+      *slicePointer = (local ? localValue : bufferValue);
     }
-    // Increment the pointers
-    dataSpacePointer += pointerIncrement;
-  }
-  if(doBufferZone){ // Note: we don't need to finish this at all if not doing buffer zone
-    for(; i < upperBound; i++){
-      if(dimIndex == 0){
-        *dataSpacePointer = bufferValue;
-      }
-      else{
-        fillDimension(bufferValue, bufferValue, doBufferZone, doLocal, dataSpacePointer, dimIndex - 1);
-      }
+    else{
+      fillDimension((local ? localValue : bufferValue), bufferValue, doBufferZone, doLocal, slicePointer, dimIndex - 1);
     }
-    dataSpacePointer += pointerIncrement;
   }
-
 }
 
 template<typename T>
@@ -1370,7 +1567,8 @@ void ValueLayerND<T>::writeDimension(std::ofstream& outfile, T* dataSpacePointer
 
 template<typename T>
 ValueLayerNDSU<T>::ValueLayerNDSU(vector<int> processesPerDim, GridDimensions globalBoundaries, int bufferSize, bool periodic,
-    T initialValue, T initialBufferZoneValue): AbstractValueLayerND<T>(processesPerDim, globalBoundaries, bufferSize, periodic){
+    T initialValue, T initialBufferZoneValue, typename AbstractValueLayerND<T>::Exchange exchangeStrategy):
+    AbstractValueLayerND<T>(processesPerDim, globalBoundaries, bufferSize, periodic, exchangeStrategy){
 
   // Create the actual arrays for the data
   dataSpace1 = new T[AbstractValueLayerND<T>::length];
@@ -1378,16 +1576,27 @@ ValueLayerNDSU<T>::ValueLayerNDSU(vector<int> processesPerDim, GridDimensions gl
   currentDataSpace = dataSpace1;
   otherDataSpace   = dataSpace2;
 
+  // Create the requests that will synchronize each bank
+  syncRequests1 = new MPI_Request[AbstractValueLayerND<T>::syncRequestCount];
+  syncRequests2 = new MPI_Request[AbstractValueLayerND<T>::syncRequestCount];
+  this->initSynchronizeRequests(dataSpace1, syncRequests1);
+  this->initSynchronizeRequests(dataSpace2, syncRequests2);
+
   // Finally, fill the data with the initial values
   initialize(initialValue, initialBufferZoneValue);
 
   // And synchronize
-  synchronize();
+  this->synchronize();
 
 }
 
 template<typename T>
 ValueLayerNDSU<T>::~ValueLayerNDSU(){
+  this->endSynchronize();
+  this->freeSynchronizeRequests(syncRequests1);
+  this->freeSynchronizeRequests(syncRequests2);
+  delete[] syncRequests1;
+  delete[] syncRequests2;
   delete[] currentDataSpace;
   delete[] otherDataSpace;
 }
@@ -1450,27 +1659,8 @@ T ValueLayerNDSU<T>::getValueAt(vector<int> location, bool& errFlag){
 
 
 template<typename T>
-void ValueLayerNDSU<T>::synchronize(){
-  AbstractValueLayerND<T>::syncCount++;
-  if(AbstractValueLayerND<T>::syncCount > 9) AbstractValueLayerND<T>::syncCount = 0;
-  int mpiTag = AbstractValueLayerND<T>::instanceID * 10 + AbstractValueLayerND<T>::syncCount;
-  // Note: the syncCount and send/recv directions are used to create a unique tag value for the
-  // mpi sends and receives. The tag value must be unique in two ways: first, successive calls to this
-  // function must be different enough that they can't be confused. The 'syncCount' value is used to
-  // achieve this, and it will loop from 0-9 and then repeat. The second, the tag must sometimes
-  // differentiate between sends and receives that are going to the same rank. If a dimension
-  // has only 2 processes but wrap-around borders, then one process may be sending to the other
-  // process twice (once left and once right). The 'sendDir' and 'recvDir' values trap this
-
-  // For each entry in neighbors:
-  MPI_Status statuses[AbstractValueLayerND<T>::neighborCount * 2];
-  for(int i = 0; i < AbstractValueLayerND<T>::neighborCount; i++){
-    MPI_Isend(&currentDataSpace[AbstractValueLayerND<T>::neighborData[i].sendPtrOffset], 1, AbstractValueLayerND<T>::neighborData[i].datatype,
-        AbstractValueLayerND<T>::neighborData[i].rank, 10 * (AbstractValueLayerND<T>::neighborData[i].sendDir + 1) + mpiTag, AbstractValueLayerND<T>::cartTopology->topologyComm, &AbstractValueLayerND<T>::requests[i]);
-    MPI_Irecv(&currentDataSpace[AbstractValueLayerND<T>::neighborData[i].receivePtrOffset], 1, AbstractValueLayerND<T>::neighborData[i].datatype,
-        AbstractValueLayerND<T>::neighborData[i].rank, 10 * (AbstractValueLayerND<T>::neighborData[i].recvDir + 1) + mpiTag, AbstractValueLayerND<T>::cartTopology->topologyComm, &AbstractValueLayerND<T>::requests[AbstractValueLayerND<T>::neighborCount + i]);
-  }
-  MPI_Waitall(AbstractValueLayerND<T>::neighborCount * 2, AbstractValueLayerND<T>::requests, statuses);
+void ValueLayerNDSU<T>::beginSynchronize(){
+  this->startSynchronizeRequests(currentDataSpace == dataSpace1 ? syncRequests1 : syncRequests2);
 }
 
 template<typename T>
@@ -1576,14 +1766,25 @@ T ValueLayerNDSU<T>::getSecondaryValueAt(vector<int> location, bool& errFlag){
 
 template<typename T>
 void ValueLayerNDSU<T>::copyCurrentToSecondary(){
-  T d = 0;
-  memcpy(otherDataSpace, currentDataSpace, AbstractValueLayerND<T>::length * sizeof d);
+  copyDataSpace(otherDataSpace, currentDataSpace);
 }
 
 template<typename T>
 void ValueLayerNDSU<T>::copySecondaryToCurrent(){
-  T d = 0;
-  memcpy(currentDataSpace, otherDataSpace, AbstractValueLayerND<T>::length * sizeof d);
+  copyDataSpace(currentDataSpace, otherDataSpace);
+}
+
+template<typename T>
+void ValueLayerNDSU<T>::copyDataSpace(T* destination, T* source){
+  // Each thread copies one contiguous part of the data space
+  int threads = getThreadCount();
+  int length  = AbstractValueLayerND<T>::length;
+#pragma omp parallel for num_threads(threads) if(threads > 1)
+  for(int t = 0; t < threads; t++){
+    int start = (int)((long)length * t / threads);
+    int end   = (int)((long)length * (t + 1) / threads);
+    memcpy(destination + start, source + start, (end - start) * sizeof(T));
+  }
 }
 
 template<typename T>
@@ -1663,50 +1864,22 @@ void ValueLayerNDSU<T>::fillDimension(T localValue, T bufferValue, bool doBuffer
 
   int pointerIncrement = AbstractValueLayerND<T>::places[dimIndex];
 
-
-  int i = 0;
-  for(; i < bufferEdge; i++){
-    if(doBufferZone){
-      if(dimIndex == 0){
-        *dataSpace1Pointer = bufferValue;
-        *dataSpace2Pointer = bufferValue;
-      }
-      else{
-        fillDimension(bufferValue, bufferValue, doBufferZone, doLocal, dataSpace1Pointer, dataSpace2Pointer, dimIndex - 1);
-      }
-    }
-    // Increment the pointers
-    dataSpace1Pointer += pointerIncrement;
-    dataSpace2Pointer += pointerIncrement;
-  }
-  for(; i < localEdge; i++){
-    if(doLocal){
-      if(dimIndex == 0){
-        *dataSpace1Pointer = localValue;
-        *dataSpace2Pointer = localValue;
-      }
-      else{
-        fillDimension(localValue, bufferValue, doBufferZone, doLocal, dataSpace1Pointer, dataSpace2Pointer, dimIndex - 1);
-      }
+  // The outermost dimension is split across threads
+  int threads = (dimIndex == AbstractValueLayerND<T>::numDims - 1 ? getThreadCount() : 1);
+#pragma omp parallel for num_threads(threads) if(threads > 1)
+  for(int i = 0; i < upperBound; i++){
+    bool local = (i >= bufferEdge && i < localEdge);
+    if(local ? !doLocal : !doBufferZone) continue;
+    T* slice1Pointer = dataSpace1Pointer + i * pointerIncrement;
+    T* slice2Pointer = dataSpace2Pointer + i * pointerIncrement;
+    if(dimIndex == 0){
+      *slice1Pointer = (local ? localValue : bufferValue);
+      *slice2Pointer = (local ? localValue : bufferValue);
     }
-    // Increment the pointers
-    dataSpace1Pointer += pointerIncrement;
-    dataSpace2Pointer += pointerIncrement;
-  }
-  if(doBufferZone){ // Note: we don't need to finish this at all if not doing buffer zone
-    for(; i < upperBound; i++){
-      if(dimIndex == 0){
-        *dataSpace1Pointer = bufferValue;
-        *dataSpace2Pointer = bufferValue;
-      }
-      else{
-        fillDimension(bufferValue, bufferValue, doBufferZone, doLocal, dataSpace1Pointer, dataSpace2Pointer, dimIndex - 1);
-      }
+    else{
+      fillDimension((local ? localValue : bufferValue), bufferValue, doBufferZone, doLocal, slice1Pointer, slice2Pointer, dimIndex - 1);
     }
-    dataSpace1Pointer += pointerIncrement;
-    dataSpace2Pointer += pointerIncrement;
   }
-
 }
 
 template<typename T>
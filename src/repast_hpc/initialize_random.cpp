@@ -65,6 +65,9 @@ const string EXPONENTIAL_DIST = "exponential";
 const string NORMAL_DIST = "normal";
 const string LOG_NORMAL_DIST = "lognormal";
 
+const string MT19937_ENGINE = "mt19937";
+const string PHILOX_ENGINE = "philox";
+
 void initializeSeed(const Properties& props, boost::mpi::communicator* comm);
 
 void createDblUni(string& name, vector<string>& params) {
@@ -187,6 +190,14 @@ void initializeRandom(Properties& props, boost::mpi::communicator* comm) {
 	}
 }
 
+RandomEngine::Type engineType(const Properties& props) {
+  if(!props.contains(RANDOM_ENGINE_PROPERTY)) return RandomEngine::MT19937;
+  string propVal = trim(props.getProperty(RANDOM_ENGINE_PROPERTY));
+  if(propVal == MT19937_ENGINE) return RandomEngine::MT19937;
+  if(propVal == PHILOX_ENGINE)  return RandomEngine::PHILOX;
+  throw Repast_Error_61(propVal); // Unrecognized engine name
+}
+
 void initializeSeed(Properties& props, boost::mpi::communicator* comm) {
   // Default value for seed is local proc's system time
   boost::uint32_t seed = (boost::uint32_t)time(0);
@@ -225,7 +236,7 @@ void initializeSeed(Properties& props, boost::mpi::communicator* comm) {
     ss << std::fixed << seed;
     props.putProperty(RANDOM_SEED_PROPERTY, ss.str());
   }
-  Random::initialize(seed);
+  Random::initialize(seed, engineType(props));
 }
 
 }
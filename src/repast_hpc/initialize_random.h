@@ -47,12 +47,17 @@
 
 #define GLOBAL_RANDOM_SEED_PROPERTY "global.random.seed"
 #define RANDOM_SEED_PROPERTY "random.seed"
+#define RANDOM_ENGINE_PROPERTY "random.engine"
 
 namespace repast {
 
 /**
- * Initializes the Random singleton with any properties (seed,
+ * Initializes the Random singleton with any properties (seed, engine,
  * distributions) found in the properties object.
+ *
+ * The engine is set by "random.engine": 'mt19937' (the default) or
+ * 'philox', a counter-based engine (see RandomEngine and
+ * Random::createStream).
  */
 void initializeRandom(Properties& props, boost::mpi::communicator* comm = 0);
 
@@ -121,6 +126,8 @@ void initializeRandom(Properties& props, boost::mpi::communicator* comm = 0);
  *     The random number seed in the properties collection will be used by each process to create
  *     different random seeds according to rank; these are then used to initialize the random
  *     number generation system.
+ *
+ * The engine of the type given by 'random.engine' (see initializeRandom) is seeded with the seed.
  */
 void initializeSeed(Properties& props, boost::mpi::communicator* comm);
 
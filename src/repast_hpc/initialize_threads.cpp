@@ -0,0 +1,83 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  initialize_threads.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "initialize_threads.h"
+#include "Utilities.h"
+#include "RepastErrors.h"
+
+using namespace std;
+
+namespace repast {
+
+namespace {
+
+int threadCount = 1;
+
+}
+
+void initializeThreads(Properties& props) {
+  if(!props.contains(THREAD_COUNT_PROPERTY)) return;
+  string propVal = trim(props.getProperty(THREAD_COUNT_PROPERTY));
+  if(propVal.compare("AUTO") == 0){
+#ifdef _OPENMP
+    setThreadCount(omp_get_max_threads());
+#else
+    setThreadCount(1);
+#endif
+    return;
+  }
+  int count = 0;
+  if(propVal.find_first_not_of("0123456789") == string::npos && propVal.size() > 0 && propVal.size() < 10) count = strToInt(propVal);
+  if(count < 1) throw Repast_Error_59(propVal); // Not a positive number of threads or AUTO
+  setThreadCount(count);
+}
+
+void setThreadCount(int count) {
+  threadCount = (count < 1 ? 1 : count);
+}
+
+int getThreadCount() {
+  return threadCount;
+}
+
+}
@@ -0,0 +1,78 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  initialize_threads.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INITTHREADS_H_
+#define INITTHREADS_H_
+
+#include "Properties.h"
+
+#define THREAD_COUNT_PROPERTY "thread.count"
+
+namespace repast {
+
+/**
+ * Sets the number of threads each process uses for its local block in
+ * value layer operations (ValueLayerND and ValueLayerNDSU initialization
+ * and bank copies, DiffusionLayerND diffusion) and for parallel agent loops
+ * (forEachAgentInParallel) from the "thread.count" property, if it is present.
+ *
+ * The value is either a positive number of threads or 'AUTO', which uses
+ * the OpenMP default for the process (OMP_NUM_THREADS if it is set,
+ * otherwise the number of cores available). This allows one process per
+ * NUMA domain or node instead of one per core; place the processes (e.g.
+ * with mpirun's binding options) so that their threads have cores to run on.
+ */
+void initializeThreads(Properties& props);
+
+/**
+ * Sets the number of threads each process uses for value layer operations
+ * and parallel agent loops.
+ * The default is 1, which performs them on the calling thread.
+ */
+void setThreadCount(int count);
+
+/**
+ * Gets the number of threads each process uses for value layer operations
+ * and parallel agent loops.
+ */
+int getThreadCount();
+
+}
+
+#endif /* INITTHREADS_H_ */
@@ -7,13 +7,16 @@ Graph.cpp \
 GridComponents.cpp \
 GridDimensions.cpp \
 initialize_random.cpp \
+initialize_threads.cpp \
 io.cpp \
 logger.cpp \
 NCDataSet.cpp \
 NCDataSetBuilder.cpp \
 NetworkBuilder.cpp \
+ParallelAgents.cpp \
 Properties.cpp \
 Random.cpp \
+RandomStream.cpp \
 RelativeLocation.cpp \
 RepastErrors.cpp \
 RepastProcess.cpp \
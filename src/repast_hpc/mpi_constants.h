@@ -57,6 +57,18 @@ const int EXPORTER_UPDATE_IMPORTERS = 1008;
 const int AGENT_MOVED_SENDERS = 1009;
 const int AGENT_MOVED_AGENT = 1010;
 
+const int AGENT_REQUEST_SPARSE_EVEN = 1011;
+const int AGENT_REQUEST_SPARSE_ODD = 1012;
+
+const int SR_REDUCE_SCATTER = 1013;
+const int SR_NBX_EVEN = 1014;
+const int SR_NBX_ODD = 1015;
+
+const int AGENT_REQUEST_CONTENT = 1016;
+const int AGENT_SYNC_STATE_CONTENT = 1017;
+const int AGENT_SYNC_PROJ_CONTENT = 1018;
+const int AGENT_MOVED_CONTENT = 1019;
+
 
 }
 
@@ -43,6 +43,7 @@
 #define AGENTPACKAGE_H
 
 #include "repast_hpc/AgentId.h"
+#include "repast_hpc/RepastProcess.h"
 
 struct AgentPackage {
 
@@ -67,6 +68,7 @@ struct AgentPackage {
 	}
 };
 
-
+// AgentPackage is plain data, so it can be exchanged as raw bytes
+REPAST_CONTENT_IS_TRIVIALLY_COPYABLE(AgentPackage)
 
 #endif /* AGENTCONTENT_H_ */
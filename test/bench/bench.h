@@ -0,0 +1,75 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * bench.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <string>
+#include <vector>
+
+#include <boost/mpi/communicator.hpp>
+
+/**
+ * A benchmark is invoked on every process with the communicator and any
+ * arguments that followed its name on the command line. Results are
+ * reported by rank 0.
+ */
+typedef void (*Benchmark)(boost::mpi::communicator& world, const std::vector<std::string>& args);
+
+/**
+ * Gets the integer argument at index, or def if it was not given.
+ */
+int intArg(const std::vector<std::string>& args, size_t index, int def);
+
+void diffusionBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args);
+
+void gridBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args);
+
+void randomBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args);
+
+void spaceBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args);
+
+void srManagerBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args);
+
+void syncBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args);
+
+void valueLayerBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args);
+
+#endif /* BENCH_H_ */
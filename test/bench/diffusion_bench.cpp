@@ -0,0 +1,118 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * diffusion_bench.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Compares the per-cell DiffusionLayerND::diffuse(Diffusor<T>*) path with
+ *  the row-wise stencil path. A periodic 2D layer (5-point and 9-point
+ *  stencils) and 3D layer (7-point and 27-point stencils) are decomposed
+ *  over all processes and diffused repeatedly with the given number of
+ *  threads per process; reports the time per step.
+ *
+ *  Arguments: [steps (10)] [global width in 2D (4096)] [global width in 3D (256)] [threads (1)]
+ */
+
+#include <iostream>
+#include <iomanip>
+
+#include <mpi.h>
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/DiffusionLayerND.h"
+#include "repast_hpc/initialize_threads.h"
+
+#include "bench.h"
+
+using namespace repast;
+
+namespace {
+
+double maxTime(boost::mpi::communicator& world, double elapsed) {
+	double maxElapsed;
+	MPI_Reduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, 0, world);
+	return maxElapsed;
+}
+
+template<typename Stencil>
+void benchmarkStencil(boost::mpi::communicator& world, DiffusionLayerND<double>& layer, Stencil& stencil,
+		const std::string& name, int steps) {
+	world.barrier();
+	double start = MPI_Wtime();
+	for (int i = 0; i < steps; i++) layer.diffuse(&stencil, true);
+	double perCell = maxTime(world, MPI_Wtime() - start);
+
+	world.barrier();
+	start = MPI_Wtime();
+	for (int i = 0; i < steps; i++) layer.diffuse(stencil, true);
+	double rowWise = maxTime(world, MPI_Wtime() - start);
+
+	if (world.rank() == 0) std::cout << std::setw(12) << name << std::setw(14) << (perCell / steps * 1e3) << " ms/step per-cell"
+			<< std::setw(14) << (rowWise / steps * 1e3) << " ms/step row-wise" << std::setw(10) << (perCell / rowWise) << "x" << std::endl;
+}
+
+void benchmarkLayer(boost::mpi::communicator& world, int dims, int width, int steps) {
+	std::vector<int> procsPerDim(dims, 0);
+	MPI_Dims_create(world.size(), dims, &procsPerDim[0]);
+
+	std::vector<double> origin(dims, 0), extent(dims, width);
+	GridDimensions globalBoundaries((Point<double>(origin)), Point<double>(extent));
+	DiffusionLayerND<double> layer(procsPerDim, globalBoundaries, 1, true, 1, 1);
+
+	if (world.rank() == 0) std::cout << dims << "D, procs " << world.size() << ", width " << width << ", steps " << steps
+			<< ", threads " << getThreadCount() << std::endl;
+
+	VonNeumannDiffusor<double> vonNeumann(dims, 0.5, 0.01);
+	MooreDiffusor<double> moore(dims, 0.5, 0.01);
+	EvaporationDiffusor<double> evaporation(0.01);
+	benchmarkStencil(world, layer, vonNeumann, (dims == 2 ? "5-point" : "7-point"), steps);
+	benchmarkStencil(world, layer, moore, (dims == 2 ? "9-point" : "27-point"), steps);
+	benchmarkStencil(world, layer, evaporation, "evaporation", steps);
+}
+
+}
+
+void diffusionBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args) {
+	int steps = intArg(args, 0, 10);
+	int width2D = intArg(args, 1, 4096);
+	int width3D = intArg(args, 2, 256);
+	setThreadCount(intArg(args, 3, 1));
+
+	RepastProcess::init("", &world);
+	benchmarkLayer(world, 2, width2D, steps);
+	benchmarkLayer(world, 3, width3D, steps);
+	RepastProcess::instance()->done();
+}
@@ -0,0 +1,170 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * grid_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Measures agent moves and Moore neighborhood queries per second on a
+ *  wrapped 2D discrete grid. Moves are timed on a grid keyed on the
+ *  dynamic Point<int> (moving with Point<int> and with Point<int, 2>) and
+ *  on one keyed on Point<int, 2>; queries are timed on both grids.
+ *  Reports millions of operations per second on rank 0.
+ *
+ *  Arguments: [grid side (200)] [agents in thousands (100)] [rounds (10)]
+ */
+
+#include <iostream>
+#include <iomanip>
+
+#include <mpi.h>
+
+#include "repast_hpc/Spaces.h"
+#include "repast_hpc/Context.h"
+#include "repast_hpc/Moore2DGridQuery.h"
+
+#include "bench.h"
+
+using namespace repast;
+
+namespace {
+
+class GridAgent: public Agent {
+
+private:
+	AgentId id_;
+
+public:
+	GridAgent(const AgentId& id) :
+		id_(id) {
+	}
+
+	virtual AgentId& getId() {
+		return id_;
+	}
+
+	virtual const AgentId& getId() const {
+		return id_;
+	}
+};
+
+// Accumulates the query results so they cannot be optimized away
+volatile size_t sink;
+
+void report(boost::mpi::communicator& world, const std::string& name, double ops, double elapsed) {
+	double maxElapsed;
+	MPI_Reduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, 0, world);
+	if (world.rank() == 0) std::cout << std::setw(40) << name << std::setw(12) << (ops / maxElapsed / 1e6) << " M/s"
+			<< std::endl;
+}
+
+// Each agent takes a step of up to 3 cells in x and y per round, wrapping
+// at the borders, so moves mix occupied and empty destinations.
+int step(int agent, int round, int salt) {
+	return (int) ((agent * 2654435761u + round * 40503u + salt * 97u) % 7) - 3;
+}
+
+template<typename GridType, typename PointType>
+void benchmarkMoves(boost::mpi::communicator& world, GridType* grid, const std::string& name, int agents, int rounds) {
+	std::vector<int> xs(agents), ys(agents);
+	for (int i = 0; i < agents; i++) {
+		xs[i] = step(i, 0, 1) * 11 + i;
+		ys[i] = step(i, 0, 2) * 13 + i / 7;
+		grid->moveTo(AgentId(i, world.rank(), 0), PointType(xs[i], ys[i]));
+	}
+
+	double start = MPI_Wtime();
+	for (int r = 1; r <= rounds; r++) {
+		for (int i = 0; i < agents; i++) {
+			xs[i] += step(i, r, 1);
+			ys[i] += step(i, r, 2);
+			grid->moveTo(AgentId(i, world.rank(), 0), PointType(xs[i], ys[i]));
+		}
+	}
+	report(world, name, (double) agents * rounds, MPI_Wtime() - start);
+}
+
+template<typename GridType>
+void benchmarkQueries(boost::mpi::communicator& world, GridType* grid, const std::string& name, int agents, int rounds) {
+	Moore2DGridQuery<GridAgent> query(grid);
+	std::vector<GridAgent*> out;
+	std::vector<int> location;
+	size_t found = 0;
+
+	double start = MPI_Wtime();
+	for (int r = 0; r < rounds; r++) {
+		for (int i = 0; i < agents; i++) {
+			grid->getLocation(AgentId(i, world.rank(), 0), location);
+			out.clear();
+			query.query(Point<int> (location), 1, false, out);
+			found += out.size();
+		}
+	}
+	sink = found;
+	report(world, name, (double) agents * rounds, MPI_Wtime() - start);
+}
+
+}
+
+void gridBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args) {
+	int side = intArg(args, 0, 200);
+	int agents = intArg(args, 1, 100) * 1000;
+	int rounds = intArg(args, 2, 10);
+
+	if (world.rank() == 0) std::cout << "procs " << world.size() << ", grid " << side << "x" << side << ", agents "
+			<< agents << ", rounds " << rounds << std::endl;
+
+	GridDimensions dims(Point<double> (side, side));
+	Context<GridAgent> context;
+	Spaces<GridAgent>::MultipleWrappedDiscreteSpace* dynamicGrid =
+			new Spaces<GridAgent>::MultipleWrappedDiscreteSpace("dynamic", dims);
+	Spaces<GridAgent>::MultipleWrappedDiscreteSpace2D* fixedGrid =
+			new Spaces<GridAgent>::MultipleWrappedDiscreteSpace2D("fixed", dims);
+	context.addProjection(dynamicGrid);
+	context.addProjection(fixedGrid);
+	for (int i = 0; i < agents; i++) {
+		context.addAgent(new GridAgent(AgentId(i, world.rank(), 0)));
+	}
+
+	benchmarkMoves<Spaces<GridAgent>::MultipleWrappedDiscreteSpace, Point<int> > (world, dynamicGrid,
+			"moveTo Point<int>, dynamic grid", agents, rounds);
+	benchmarkMoves<Spaces<GridAgent>::MultipleWrappedDiscreteSpace, Point<int, 2> > (world, dynamicGrid,
+			"moveTo Point<int, 2>, dynamic grid", agents, rounds);
+	benchmarkMoves<Spaces<GridAgent>::MultipleWrappedDiscreteSpace2D, Point<int, 2> > (world, fixedGrid,
+			"moveTo Point<int, 2>, fixed grid", agents, rounds);
+
+	benchmarkQueries(world, dynamicGrid, "Moore query, dynamic grid", agents, rounds);
+	benchmarkQueries(world, fixedGrid, "Moore query, fixed grid", agents, rounds);
+}
@@ -0,0 +1,83 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * main.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Usage: mpirun -n <procs> rhpc_benchmarks <benchmark> [args...]
+ */
+
+#include <iostream>
+#include <map>
+#include <cstdlib>
+
+#include <boost/mpi.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "bench.h"
+
+int intArg(const std::vector<std::string>& args, size_t index, int def) {
+	return (index < args.size() ? boost::lexical_cast<int>(args[index]) : def);
+}
+
+int main(int argc, char **argv) {
+	boost::mpi::environment env(argc, argv);
+	boost::mpi::communicator world;
+
+	std::map<std::string, Benchmark> benchmarks;
+	benchmarks["diffusion"] = &diffusionBenchmark;
+	benchmarks["grid"] = &gridBenchmark;
+	benchmarks["random"] = &randomBenchmark;
+	benchmarks["space"] = &spaceBenchmark;
+	benchmarks["sr_manager"] = &srManagerBenchmark;
+	benchmarks["sync"] = &syncBenchmark;
+	benchmarks["value_layer"] = &valueLayerBenchmark;
+
+	std::map<std::string, Benchmark>::iterator found = (argc > 1 ? benchmarks.find(argv[1]) : benchmarks.end());
+	if (found == benchmarks.end()) {
+		if (world.rank() == 0) {
+			std::cerr << "usage: " << argv[0] << " <benchmark> [args...]" << std::endl << "benchmarks:";
+			for (std::map<std::string, Benchmark>::iterator iter = benchmarks.begin(); iter != benchmarks.end(); ++iter)
+				std::cerr << " " << iter->first;
+			std::cerr << std::endl;
+		}
+		return 1;
+	}
+
+	std::vector<std::string> args(argv + 2, argv + argc);
+	found->second(world, args);
+	return 0;
+}
@@ -0,0 +1,12 @@
+SOURCES = diffusion_bench.cpp \
+          grid_bench.cpp \
+          main.cpp \
+          random_bench.cpp \
+          space_bench.cpp \
+          sr_manager_bench.cpp \
+          sync_bench.cpp \
+          value_layer_bench.cpp
+
+local_dir := bench
+local_src := $(addprefix $(local_dir)/, $(SOURCES))
+bench_src += $(local_src)
@@ -0,0 +1,120 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * random_bench.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Compares the throughput of the Random singleton with the mt19937 and
+ *  Philox engines: raw 32-bit draws, nextDouble, and an int uniform
+ *  generator. Also times creating a per-agent stream with
+ *  Random::createStream and drawing a few numbers from it, as an agent
+ *  would each tick. Reports millions of draws per second on rank 0.
+ *
+ *  Arguments: [draws in millions (20)] [agents in thousands (1000)]
+ */
+
+#include <iostream>
+#include <iomanip>
+
+#include <mpi.h>
+
+#include "repast_hpc/Random.h"
+#include "repast_hpc/AgentId.h"
+
+#include "bench.h"
+
+using namespace repast;
+
+namespace {
+
+const int DRAWS_PER_AGENT = 4;
+
+// Accumulates the draws so they cannot be optimized away
+volatile double sink;
+
+void report(boost::mpi::communicator& world, const std::string& engine, const std::string& name, double draws,
+		double elapsed) {
+	double maxElapsed;
+	MPI_Reduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, 0, world);
+	if (world.rank() == 0) std::cout << std::setw(8) << engine << std::setw(22) << name << std::setw(12)
+			<< (draws / maxElapsed / 1e6) << " M/s" << std::endl;
+}
+
+void benchmarkEngine(boost::mpi::communicator& world, RandomEngine::Type type, const std::string& engineName,
+		int draws, int agents) {
+	Random::initialize(1234 + world.rank(), type);
+	Random* random = Random::instance();
+
+	double start = MPI_Wtime();
+	boost::uint32_t bits = 0;
+	RandomEngine& engine = random->engine();
+	for (int i = 0; i < draws; i++) bits ^= engine();
+	sink = bits;
+	report(world, engineName, "engine()", draws, MPI_Wtime() - start);
+
+	start = MPI_Wtime();
+	double sum = 0;
+	for (int i = 0; i < draws; i++) sum += random->nextDouble();
+	sink = sum;
+	report(world, engineName, "nextDouble()", draws, MPI_Wtime() - start);
+
+	IntUniformGenerator gen = random->createUniIntGenerator(0, 99);
+	start = MPI_Wtime();
+	sum = 0;
+	for (int i = 0; i < draws; i++) sum += gen.next();
+	sink = sum;
+	report(world, engineName, "int_uniform", draws, MPI_Wtime() - start);
+
+	start = MPI_Wtime();
+	sum = 0;
+	for (int i = 0; i < agents; i++) {
+		RandomStream stream = random->createStream(AgentId(i, world.rank(), 0), 1);
+		for (int j = 0; j < DRAWS_PER_AGENT; j++) sum += stream.nextDouble();
+	}
+	sink = sum;
+	report(world, engineName, "createStream+4 draws", (double) agents * DRAWS_PER_AGENT, MPI_Wtime() - start);
+}
+
+}
+
+void randomBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args) {
+	int draws = intArg(args, 0, 20) * 1000000;
+	int agents = intArg(args, 1, 1000) * 1000;
+
+	if (world.rank() == 0) std::cout << "procs " << world.size() << ", draws " << draws << ", agents " << agents << std::endl;
+	benchmarkEngine(world, RandomEngine::MT19937, "mt19937", draws, agents);
+	benchmarkEngine(world, RandomEngine::PHILOX, "philox", draws, agents);
+}
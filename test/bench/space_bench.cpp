@@ -0,0 +1,189 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * space_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Measures neighborhood queries on a wrapped 2D continuous space. Each
+ *  agent asks for its neighbors within the radius, once through the
+ *  binned index of an indexed space and once by scanning every agent in
+ *  the space, as models without the index have to. Moves are timed on
+ *  both an indexed and a plain space to show the cost of keeping the
+ *  index up to date. Reports millions of operations per second on rank 0.
+ *
+ *  Arguments: [side per process (100)] [agents per process in thousands (10)]
+ *  [radius (1)] [rounds (5)]
+ */
+
+#include <iostream>
+#include <iomanip>
+
+#include <mpi.h>
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/SharedSpaces.h"
+
+#include "bench.h"
+
+using namespace repast;
+
+namespace {
+
+class SpaceAgent: public Agent {
+
+private:
+	AgentId id_;
+
+public:
+	SpaceAgent(const AgentId& id) :
+		id_(id) {
+	}
+
+	virtual AgentId& getId() {
+		return id_;
+	}
+
+	virtual const AgentId& getId() const {
+		return id_;
+	}
+};
+
+typedef SharedSpaces<SpaceAgent>::SharedWrappedContinuousSpace PlainSpace;
+typedef SharedSpaces<SpaceAgent>::SharedWrappedIndexedContinuousSpace IndexedSpace;
+
+// Accumulates the query results so they cannot be optimized away
+volatile size_t sink;
+
+void report(boost::mpi::communicator& world, const std::string& name, double ops, double elapsed) {
+	double maxElapsed;
+	MPI_Reduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, 0, world);
+	if (world.rank() == 0) std::cout << std::setw(40) << name << std::setw(12) << (ops / maxElapsed / 1e6) << " M/s"
+			<< std::endl;
+}
+
+// Pseudo random coordinate in [0, side), repeatable across runs
+double coordinate(int agent, int round, int salt, int side) {
+	return ((agent * 2654435761u + round * 40503u + salt * 97u) % (side * 1000u)) / 1000.0;
+}
+
+template<typename SpaceType>
+void benchmarkMoves(boost::mpi::communicator& world, SpaceType* space, const std::string& name, int side,
+		int agents, int rounds) {
+	double x = world.rank() * side;
+	double start = MPI_Wtime();
+	for (int r = 0; r < rounds; r++) {
+		for (int i = 0; i < agents; i++) {
+			space->moveTo(AgentId(i, world.rank(), 0),
+					Point<double, 2> (x + coordinate(i, r, 1, side), coordinate(i, r, 2, side)));
+		}
+	}
+	report(world, name, (double) agents * rounds, MPI_Wtime() - start);
+}
+
+void benchmarkIndexedQueries(boost::mpi::communicator& world, IndexedSpace* space, int agents, double radius,
+		int rounds) {
+	std::vector<SpaceAgent*> out;
+	std::vector<double> location;
+	size_t found = 0;
+
+	double start = MPI_Wtime();
+	for (int r = 0; r < rounds; r++) {
+		for (int i = 0; i < agents; i++) {
+			space->getLocation(AgentId(i, world.rank(), 0), location);
+			out.clear();
+			space->queryRadius(Point<double, 2> (location[0], location[1]), radius, out);
+			found += out.size();
+		}
+	}
+	sink = found;
+	report(world, "queryRadius, indexed space", (double) agents * rounds, MPI_Wtime() - start);
+}
+
+void benchmarkScanQueries(boost::mpi::communicator& world, PlainSpace* space, int agents, double radius) {
+	std::vector<double> location, other;
+	double radiusSq = radius * radius;
+	size_t found = 0;
+
+	double start = MPI_Wtime();
+	for (int i = 0; i < agents; i++) {
+		space->getLocation(AgentId(i, world.rank(), 0), location);
+		Point<double> center(location);
+		for (int j = 0; j < agents; j++) {
+			space->getLocation(AgentId(j, world.rank(), 0), other);
+			if (space->getDistanceSq(center, Point<double> (other)) <= radiusSq) found++;
+		}
+	}
+	sink = found;
+	report(world, "scan all agents, plain space", (double) agents, MPI_Wtime() - start);
+}
+
+}
+
+void spaceBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args) {
+	int side = intArg(args, 0, 100);
+	int agents = intArg(args, 1, 10) * 1000;
+	int radius = intArg(args, 2, 1);
+	int rounds = intArg(args, 3, 5);
+
+	if (world.rank() == 0) std::cout << "procs " << world.size() << ", space " << side << "x" << side
+			<< " per process, agents " << agents << ", radius " << radius << ", rounds " << rounds << std::endl;
+
+	RepastProcess::init("", &world);
+	{
+		std::vector<int> processDims;
+		processDims.push_back(world.size());
+		processDims.push_back(1);
+		GridDimensions dims(Point<double> (0, 0), Point<double> (side * world.size(), side));
+
+		SharedContext<SpaceAgent> context(&world);
+		PlainSpace* plainSpace = new PlainSpace("plain", dims, processDims, 0, &world);
+		IndexedSpace* indexedSpace = new IndexedSpace("indexed", dims, processDims, 0, &world);
+		indexedSpace->setQueryBinWidth(radius);
+		context.addProjection(plainSpace);
+		context.addProjection(indexedSpace);
+		for (int i = 0; i < agents; i++) {
+			context.addAgent(new SpaceAgent(AgentId(i, world.rank(), 0)));
+		}
+
+		benchmarkMoves(world, plainSpace, "moveTo Point<double, 2>, plain space", side, agents, rounds);
+		benchmarkMoves(world, indexedSpace, "moveTo Point<double, 2>, indexed space", side, agents, rounds);
+
+		benchmarkIndexedQueries(world, indexedSpace, agents, radius, rounds);
+		benchmarkScanQueries(world, plainSpace, agents, radius);
+	}
+	RepastProcess::instance()->done();
+}
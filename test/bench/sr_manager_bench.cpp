@@ -0,0 +1,94 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * sr_manager_bench.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Compares the SRManager partner discovery engines. Each process marks
+ *  a fixed number of partners (its nearest neighbors by rank, as in a
+ *  domain decomposition) and retrieves its sources repeatedly.
+ *
+ *  Arguments: [partners (8)] [iterations (1000)]
+ *  Run at increasing process counts, e.g. 64 through 4096, to compare scaling.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+#include <mpi.h>
+
+#include "repast_hpc/SRManager.h"
+
+#include "bench.h"
+
+void srManagerBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args) {
+	int partners = intArg(args, 0, 8);
+	int iterations = intArg(args, 1, 1000);
+	int size = world.size();
+	int rank = world.rank();
+
+	// Alternate up and down by rank: +1, -1, +2, -2, ...
+	std::vector<int> targets;
+	for (int i = 0; (int) targets.size() < partners && (int) targets.size() < size - 1; i++) {
+		int d = i / 2 + 1;
+		int target = (i % 2 == 0 ? (rank + d) % size : ((rank - d) % size + size) % size);
+		if (std::find(targets.begin(), targets.end(), target) == targets.end()) targets.push_back(target);
+	}
+
+	const char* names[] = { "ALLTOALL", "REDUCE_SCATTER", "NBX" };
+	SRManager::Engine engines[] = { SRManager::ALLTOALL, SRManager::REDUCE_SCATTER, SRManager::NBX };
+
+	if (rank == 0) std::cout << "procs " << size << ", partners " << targets.size() << ", iterations " << iterations << std::endl;
+
+	for (int e = 0; e < 3; e++) {
+		size_t found = 0;
+		world.barrier();
+		double start = MPI_Wtime();
+		for (int i = 0; i < iterations; i++) {
+			std::vector<int> sources;
+			SRManager manager(&world, engines[e]);
+			manager.retrieveSources(targets, sources);
+			found += sources.size();
+		}
+		double elapsed = MPI_Wtime() - start;
+		double maxElapsed;
+		MPI_Reduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, 0, world);
+
+		if (found != targets.size() * iterations) std::cerr << "rank " << rank << ": " << names[e] << " found " << found << " sources, expected " << targets.size() * iterations << std::endl;
+		if (rank == 0) std::cout << std::setw(16) << names[e] << std::setw(14) << (maxElapsed / iterations * 1e6) << " us/call" << std::endl;
+	}
+}
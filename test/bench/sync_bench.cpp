@@ -0,0 +1,270 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * sync_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ *  Measures the per tick cost of synchronizing projection information on
+ *  a wrapped 2D discrete grid with a buffer of 1. The bookkeeping that
+ *  finds the local agents to push into the neighbors' buffer zones is
+ *  timed with std::set<AgentId> and with AgentIdSet containers, then
+ *  through SharedContext::getAgentsToPushToOtherProcesses, and finally
+ *  RepastProcess::synchronizeProjectionInfo is timed as a whole. Reports
+ *  millions of local agents processed per second on rank 0.
+ *
+ *  Arguments: [agents per process in thousands (100)] [rounds (5)]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <set>
+#include <map>
+#include <cmath>
+
+#include <mpi.h>
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/SharedSpaces.h"
+#include "repast_hpc/AgentIdSet.h"
+
+#include "bench.h"
+
+using namespace repast;
+
+namespace {
+
+class SyncAgent: public Agent {
+
+private:
+	AgentId id_;
+
+public:
+	SyncAgent(const AgentId& id) :
+		id_(id) {
+	}
+
+	virtual AgentId& getId() {
+		return id_;
+	}
+
+	virtual const AgentId& getId() const {
+		return id_;
+	}
+};
+
+struct SyncPackage {
+	int id, proc, type, currentProc;
+
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int version) {
+		ar & id;
+		ar & proc;
+		ar & type;
+		ar & currentProc;
+	}
+};
+
+typedef SharedSpaces<SyncAgent>::SharedWrappedDiscreteSpace SyncGrid;
+
+/**
+ * Provides, updates and creates SyncAgents for synchronizeProjectionInfo.
+ */
+class SyncModel {
+
+public:
+	SharedContext<SyncAgent> context;
+	SyncGrid* grid;
+
+	SyncModel(boost::mpi::communicator* comm) :
+		context(comm), grid(0) {
+	}
+
+	void provideContent(const AgentRequest& request, std::vector<SyncPackage>& out) {
+		const std::vector<AgentId>& ids = request.requestedAgents();
+		for (size_t i = 0; i < ids.size(); i++) {
+			const AgentId& id = context.getAgent(ids[i])->getId();
+			SyncPackage package = { id.id(), id.startingRank(), id.agentType(), id.currentRank() };
+			out.push_back(package);
+		}
+	}
+
+	void updateAgent(const SyncPackage& package) {
+	}
+
+	SyncAgent* createAgent(const SyncPackage& package) {
+		return new SyncAgent(AgentId(package.id, package.proc, package.type, package.currentProc));
+	}
+};
+
+// Accumulates the results so they cannot be optimized away
+volatile size_t sink;
+
+void report(boost::mpi::communicator& world, const std::string& name, double ops, double elapsed) {
+	double maxElapsed;
+	MPI_Reduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, 0, world);
+	if (world.rank() == 0) std::cout << std::setw(40) << name << std::setw(12) << (ops / maxElapsed / 1e6) << " M/s"
+			<< std::endl;
+}
+
+// The rank whose buffer zone the x coordinate is in, or -1 if it is in neither
+int bufferRank(int x, int minX, int side, int left, int right) {
+	if (x == minX) return left;
+	if (x == minX + side - 1) return right;
+	return -1;
+}
+
+void benchmarkStdSet(boost::mpi::communicator& world, SyncModel& model, int side, int agents, int rounds) {
+	int minX = world.rank() * side, left = (world.rank() + world.size() - 1) % world.size(), right = (world.rank()
+			+ 1) % world.size();
+	std::vector<int> location;
+	size_t pushed = 0;
+
+	double start = MPI_Wtime();
+	for (int r = 0; r < rounds; r++) {
+		std::set<AgentId> agentsToTest;
+		std::map<int, std::set<AgentId> > agentsToPush;
+		for (SharedContext<SyncAgent>::const_local_iterator iter = model.context.localBegin(), iterEnd =
+				model.context.localEnd(); iter != iterEnd; ++iter) {
+			agentsToTest.insert((*iter)->getId());
+		}
+		std::set<AgentId>::iterator idIter = agentsToTest.begin();
+		while (idIter != agentsToTest.end()) {
+			model.grid->getLocation(*idIter, location);
+			int rank = bufferRank(location[0], minX, side, left, right);
+			if (rank >= 0) {
+				agentsToPush[rank].insert(*idIter);
+				agentsToTest.erase(idIter++);
+			} else
+				++idIter;
+		}
+		pushed += agentsToPush[left].size();
+	}
+	sink = pushed;
+	report(world, "push bookkeeping, std::set", (double) agents * rounds, MPI_Wtime() - start);
+}
+
+void benchmarkAgentIdSet(boost::mpi::communicator& world, SyncModel& model, int side, int agents, int rounds) {
+	int minX = world.rank() * side, left = (world.rank() + world.size() - 1) % world.size(), right = (world.rank()
+			+ 1) % world.size();
+	std::vector<int> location;
+	size_t pushed = 0;
+
+	AgentIdSet agentsToTest, found;
+	std::map<int, AgentIdSet> agentsToPush;
+	double start = MPI_Wtime();
+	for (int r = 0; r < rounds; r++) {
+		agentsToTest.clear();
+		found.clear();
+		for (std::map<int, AgentIdSet>::iterator iter = agentsToPush.begin(); iter != agentsToPush.end(); ++iter)
+			iter->second.clear();
+		for (SharedContext<SyncAgent>::const_local_iterator iter = model.context.localBegin(), iterEnd =
+				model.context.localEnd(); iter != iterEnd; ++iter) {
+			agentsToTest.insert((*iter)->getId());
+		}
+		for (AgentIdSet::const_iterator idIter = agentsToTest.begin(), idIterEnd = agentsToTest.end(); idIter
+				!= idIterEnd; ++idIter) {
+			model.grid->getLocation(*idIter, location);
+			int rank = bufferRank(location[0], minX, side, left, right);
+			if (rank >= 0) {
+				agentsToPush[rank].insert(*idIter);
+				found.insert(*idIter);
+			}
+		}
+		agentsToTest.erase(found);
+		pushed += agentsToPush[left].size();
+	}
+	sink = pushed;
+	report(world, "push bookkeeping, AgentIdSet", (double) agents * rounds, MPI_Wtime() - start);
+}
+
+void benchmarkGetAgentsToPush(boost::mpi::communicator& world, SyncModel& model, int agents, int rounds) {
+	std::map<int, AgentIdSet> agentsToPush;
+	size_t pushed = 0;
+
+	double start = MPI_Wtime();
+	for (int r = 0; r < rounds; r++) {
+		for (std::map<int, AgentIdSet>::iterator iter = agentsToPush.begin(); iter != agentsToPush.end(); ++iter)
+			iter->second.clear();
+		model.context.getAgentsToPushToOtherProcesses(agentsToPush);
+		pushed += agentsToPush.size();
+	}
+	sink = pushed;
+	report(world, "getAgentsToPushToOtherProcesses", (double) agents * rounds, MPI_Wtime() - start);
+}
+
+void benchmarkSynchronize(boost::mpi::communicator& world, SyncModel& model, int agents, int rounds) {
+	double start = MPI_Wtime();
+	for (int r = 0; r < rounds; r++) {
+		RepastProcess::instance()->synchronizeProjectionInfo<SyncAgent, SyncPackage, SyncModel, SyncModel, SyncModel> (
+				model.context, model, model, model, RepastProcess::USE_LAST_OR_USE_CURRENT);
+	}
+	report(world, "synchronizeProjectionInfo", (double) agents * rounds, MPI_Wtime() - start);
+}
+
+}
+
+void syncBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args) {
+	int agents = intArg(args, 0, 100) * 1000;
+	int rounds = intArg(args, 1, 5);
+
+	// about one agent per cell
+	int side = std::max(3, (int) std::sqrt((double) agents));
+
+	if (world.rank() == 0) std::cout << "procs " << world.size() << ", grid " << side << "x" << side
+			<< " per process, agents " << agents << ", rounds " << rounds << std::endl;
+
+	RepastProcess::init("", &world);
+	{
+		std::vector<int> processDims;
+		processDims.push_back(world.size());
+		processDims.push_back(1);
+		GridDimensions dims(Point<double> (0, 0), Point<double> (side * world.size(), side));
+
+		SyncModel model(&world);
+		model.grid = new SyncGrid("grid", dims, processDims, 1, &world);
+		model.context.addProjection(model.grid);
+		for (int i = 0; i < agents; i++) {
+			SyncAgent* agent = model.context.addAgent(new SyncAgent(AgentId(i, world.rank(), 0)));
+			model.grid->moveTo(agent->getId(), Point<int> (world.rank() * side + i % side, (i / side) % side));
+		}
+
+		benchmarkStdSet(world, model, side, agents, rounds);
+		benchmarkAgentIdSet(world, model, side, agents, rounds);
+		benchmarkGetAgentsToPush(world, model, agents, rounds);
+		benchmarkSynchronize(world, model, agents, rounds);
+	}
+	RepastProcess::instance()->done();
+}
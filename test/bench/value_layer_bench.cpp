@@ -0,0 +1,104 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * value_layer_bench.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Compares the ValueLayerND buffer zone exchange strategies. A periodic
+ *  2D and 3D layer is decomposed over all processes and synchronized
+ *  repeatedly at several buffer widths; for each, reports the messages
+ *  sent per synchronization and the time per synchronization.
+ *
+ *  Arguments: [iterations (1000)] [local width in 2D (256)] [local width in 3D (32)]
+ */
+
+#include <iostream>
+#include <iomanip>
+
+#include <mpi.h>
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/ValueLayerND.h"
+
+#include "bench.h"
+
+using namespace repast;
+
+namespace {
+
+void benchmarkLayer(boost::mpi::communicator& world, int dims, int localWidth, int iterations) {
+	std::vector<int> procsPerDim(dims, 0);
+	MPI_Dims_create(world.size(), dims, &procsPerDim[0]);
+
+	std::vector<double> origin(dims, 0), extent(dims);
+	for (int i = 0; i < dims; i++) extent[i] = localWidth * procsPerDim[i];
+	GridDimensions globalBoundaries((Point<double>(origin)), Point<double>(extent));
+
+	const char* names[] = { "ALL_NEIGHBORS", "DIMENSION_ORDERED" };
+	AbstractValueLayerND<double>::Exchange exchanges[] = { AbstractValueLayerND<double>::ALL_NEIGHBORS,
+			AbstractValueLayerND<double>::DIMENSION_ORDERED };
+	int buffers[] = { 1, 2, 4 };
+
+	if (world.rank() == 0) std::cout << dims << "D, procs " << world.size() << ", local width " << localWidth << ", iterations " << iterations << std::endl;
+
+	for (int b = 0; b < 3; b++) {
+		for (int e = 0; e < 2; e++) {
+			ValueLayerND<double> layer(procsPerDim, globalBoundaries, buffers[b], true, 1, 0, exchanges[e]);
+			world.barrier();
+			double start = MPI_Wtime();
+			for (int i = 0; i < iterations; i++) layer.synchronize();
+			double elapsed = MPI_Wtime() - start;
+			double maxElapsed;
+			MPI_Reduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, 0, world);
+
+			if (world.rank() == 0) std::cout << "  buffer " << buffers[b] << std::setw(20) << names[e] << std::setw(6) << layer.getSynchronizeMessageCount()
+					<< " msgs" << std::setw(14) << (maxElapsed / iterations * 1e6) << " us/sync" << std::endl;
+		}
+	}
+}
+
+}
+
+void valueLayerBenchmark(boost::mpi::communicator& world, const std::vector<std::string>& args) {
+	int iterations = intArg(args, 0, 1000);
+	int width2D = intArg(args, 1, 256);
+	int width3D = intArg(args, 2, 32);
+
+	RepastProcess::init("", &world);
+	benchmarkLayer(world, 2, width2D, iterations);
+	benchmarkLayer(world, 3, width3D, iterations);
+	RepastProcess::instance()->done();
+}
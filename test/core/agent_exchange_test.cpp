@@ -0,0 +1,339 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * agent_exchange_test.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Checks agent requests and state synchronization between processes.
+ *  Each process requests agents from the next two processes by rank, so
+ *  the tests exercise the exchange when run under mpirun with 2 or more
+ *  processes (and pass trivially on one). The agents are also placed in
+ *  a shared grid, so that projection information is exchanged with them;
+ *  the Packed tests use a trivially packable package, which sends content
+ *  and grid locations as raw bytes. The DenseGrid test keeps the grid in a
+ *  DenseMultipleOccupancy, so requested agents land outside its cell array.
+ */
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/SharedDiscreteSpace.h"
+#include "repast_hpc/GridComponents.h"
+
+#include <gtest/gtest.h>
+#include <boost/mpi.hpp>
+#include <vector>
+
+using namespace repast;
+using namespace std;
+
+/**
+ * Plain data version of ExchangePackage, exchanged as raw bytes. It is
+ * still serializable, as both exchange paths are compiled.
+ */
+struct PackedExchangePackage {
+	int id, proc, type, currentProc;
+	int value;
+
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int version) {
+		ar & id;
+		ar & proc;
+		ar & type;
+		ar & currentProc;
+		ar & value;
+	}
+};
+
+REPAST_CONTENT_IS_TRIVIALLY_COPYABLE(PackedExchangePackage)
+
+namespace {
+
+const int AGENTS_PER_PROC = 10;
+
+class ExchangeAgent: public Agent {
+
+private:
+	AgentId id_;
+
+public:
+	int value;
+
+	ExchangeAgent(const AgentId& id, int val): id_(id), value(val) {
+	}
+
+	virtual ~ExchangeAgent() {
+	}
+
+	virtual AgentId& getId() {
+		return id_;
+	}
+
+	virtual const AgentId& getId() const {
+		return id_;
+	}
+};
+
+struct ExchangePackage {
+	int id, proc, type, currentProc;
+	int value;
+
+	ExchangePackage(): id(0), proc(0), type(0), currentProc(0), value(0) {
+	}
+
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int version) {
+		ar & id;
+		ar & proc;
+		ar & type;
+		ar & currentProc;
+		ar & value;
+	}
+};
+
+typedef SharedDiscreteSpace<ExchangeAgent, WrapAroundBorders, SimpleAdder<ExchangeAgent> > ExchangeGrid;
+typedef SharedDiscreteSpace<ExchangeAgent, WrapAroundBorders, SimpleAdder<ExchangeAgent>,
+		DenseMultipleOccupancy<ExchangeAgent, int, 2> > DenseExchangeGrid;
+
+/**
+ * Provides, updates and creates agents of type ExchangeAgent from
+ * packages of type Package.
+ */
+template<typename Package, typename GridType = ExchangeGrid>
+class ExchangeModel {
+
+public:
+	SharedContext<ExchangeAgent> context;
+	GridType* grid;
+
+	// One grid column of AGENTS_PER_PROC cells per process
+	ExchangeModel(boost::mpi::communicator* comm, int buffer = 0): context(comm) {
+		vector<int> processDims;
+		processDims.push_back(comm->size());
+		processDims.push_back(1);
+		grid = new GridType("grid",
+				GridDimensions(Point<double>(0, 0), Point<double>(comm->size() * AGENTS_PER_PROC, AGENTS_PER_PROC)),
+				processDims, buffer, comm);
+		context.addProjection(grid);
+	}
+
+	void provideContent(const AgentRequest& request, vector<Package>& out) {
+		const vector<AgentId>& ids = request.requestedAgents();
+		for (size_t i = 0; i < ids.size(); i++) {
+			ExchangeAgent* agent = context.getAgent(ids[i]);
+			Package package;
+			package.id = agent->getId().id();
+			package.proc = agent->getId().startingRank();
+			package.type = agent->getId().agentType();
+			package.currentProc = agent->getId().currentRank();
+			package.value = agent->value;
+			out.push_back(package);
+		}
+	}
+
+	void updateAgent(const Package& package) {
+		AgentId id(package.id, package.proc, package.type);
+		ExchangeAgent* agent = context.getAgent(id);
+		if (agent != 0) agent->value = package.value;
+	}
+
+	ExchangeAgent* createAgent(const Package& package) {
+		AgentId id(package.id, package.proc, package.type, package.currentProc);
+		return new ExchangeAgent(id, package.value);
+	}
+};
+
+int expectedValue(int id, int proc, int round) {
+	return proc * 1000 + id + round * 100000;
+}
+
+/**
+ * Each process creates its agents, requests agents from the next two
+ * processes, then changes its agents' values and synchronizes them
+ * twice, checking the copies after each step.
+ */
+template<typename Package, typename GridType>
+void checkExchange(RepastProcess::AGENT_REQUEST_EXCHANGE exchange) {
+	boost::mpi::communicator* world = RepastProcess::instance()->getCommunicator();
+	int rank = world->rank();
+	int size = world->size();
+
+	typedef ExchangeModel<Package, GridType> Model;
+	Model model(world);
+	ASSERT_TRUE(model.context.projectionInfoIsPackable());
+	for (int i = 0; i < AGENTS_PER_PROC; i++) {
+		ExchangeAgent* agent = model.context.addAgent(new ExchangeAgent(AgentId(i, rank, 0), expectedValue(i, rank, 0)));
+		model.grid->moveTo(agent->getId(), Point<int>(rank * AGENTS_PER_PROC + i, i));
+	}
+
+	AgentRequest request(rank);
+	vector<AgentId> requested;
+	for (int d = 1; d <= 2 && d < size; d++) {
+		int other = (rank + d) % size;
+		for (int i = d - 1; i < AGENTS_PER_PROC; i += d) {
+			AgentId id(i, other, 0);
+			request.addRequest(id);
+			requested.push_back(id);
+		}
+	}
+	RepastProcess::instance()->requestAgents<ExchangeAgent, Package, Model, Model, Model>(model.context, request, model,
+			model, model, exchange);
+
+	for (size_t i = 0; i < requested.size(); i++) {
+		ExchangeAgent* agent = model.context.getAgent(requested[i]);
+		ASSERT_TRUE(agent != 0);
+		ASSERT_EQ(expectedValue(requested[i].id(), requested[i].startingRank(), 0), agent->value);
+		vector<int> location;
+		ASSERT_TRUE(model.grid->getLocation(requested[i], location));
+		ASSERT_EQ(requested[i].startingRank() * AGENTS_PER_PROC + requested[i].id(), location[0]);
+		ASSERT_EQ(requested[i].id(), location[1]);
+	}
+
+	for (int round = 1; round <= 2; round++) {
+		for (int i = 0; i < AGENTS_PER_PROC; i++)
+			model.context.getAgent(AgentId(i, rank, 0))->value = expectedValue(i, rank, round);
+		RepastProcess::instance()->synchronizeAgentStates<Package, Model, Model>(model, model);
+		for (size_t i = 0; i < requested.size(); i++)
+			ASSERT_EQ(expectedValue(requested[i].id(), requested[i].startingRank(), round), model.context.getAgent(requested[i])->value);
+	}
+}
+
+/**
+ * Checks the agents the grid pushes to its neighbors against the agents'
+ * locations: with a buffer of 1, an agent in the first or last column of
+ * this process's cells is pushed to the process on that side.
+ */
+void checkPushes(ExchangeGrid* grid, const AgentIdSet& local) {
+	boost::mpi::communicator* world = RepastProcess::instance()->getCommunicator();
+	int rank = world->rank();
+	int size = world->size();
+
+	std::map<int, AgentIdSet> expected;
+	AgentIdSet notPushed;
+	for (AgentIdSet::const_iterator iter = local.begin(); iter != local.end(); ++iter) {
+		vector<int> location;
+		int offset = grid->getLocation(*iter, location) ? location[0] - rank * AGENTS_PER_PROC : -1;
+		if (size > 1 && offset == 0)
+			expected[(rank + size - 1) % size].insert(*iter);
+		else if (size > 1 && offset == AGENTS_PER_PROC - 1)
+			expected[(rank + 1) % size].insert(*iter);
+		else
+			notPushed.insert(*iter);
+	}
+
+	AgentIdSet agentsToTest(local);
+	std::map<int, AgentIdSet> agentsToPush;
+	grid->getAgentsToPush(agentsToTest, agentsToPush);
+
+	ASSERT_EQ(expected.size(), agentsToPush.size());
+	for (std::map<int, AgentIdSet>::iterator iter = expected.begin(); iter != expected.end(); ++iter) {
+		AgentIdSet& pushed = agentsToPush[iter->first];
+		ASSERT_EQ(iter->second.size(), pushed.size());
+		ASSERT_TRUE(std::equal(iter->second.begin(), iter->second.end(), pushed.begin()));
+	}
+	ASSERT_EQ(notPushed.size(), agentsToTest.size());
+	ASSERT_TRUE(std::equal(notPushed.begin(), notPushed.end(), agentsToTest.begin()));
+}
+
+}
+
+class AgentExchangeTest: public testing::Test {
+
+public:
+	AgentExchangeTest() {
+		// Start each test with no agents requested or exported
+		RepastProcess::init("");
+	}
+
+};
+
+TEST_F(AgentExchangeTest, RequestAlltoall)
+{
+	checkExchange<ExchangePackage, ExchangeGrid>(RepastProcess::ALLTOALL);
+}
+
+TEST_F(AgentExchangeTest, RequestSparse)
+{
+	checkExchange<ExchangePackage, ExchangeGrid>(RepastProcess::SPARSE);
+}
+
+TEST_F(AgentExchangeTest, RequestAlltoallPacked)
+{
+	ASSERT_TRUE(is_trivially_packable<PackedExchangePackage>::value);
+	ASSERT_FALSE(is_trivially_packable<ExchangePackage>::value);
+	checkExchange<PackedExchangePackage, ExchangeGrid>(RepastProcess::ALLTOALL);
+}
+
+TEST_F(AgentExchangeTest, RequestSparsePacked)
+{
+	checkExchange<PackedExchangePackage, ExchangeGrid>(RepastProcess::SPARSE);
+}
+
+TEST_F(AgentExchangeTest, RequestSparseDenseGrid)
+{
+	checkExchange<PackedExchangePackage, DenseExchangeGrid>(RepastProcess::SPARSE);
+}
+
+TEST_F(AgentExchangeTest, BufferZonePush)
+{
+	boost::mpi::communicator* world = RepastProcess::instance()->getCommunicator();
+	int rank = world->rank();
+	int base = rank * AGENTS_PER_PROC;
+
+	ExchangeModel<ExchangePackage> model(world, 1);
+	AgentIdSet local;
+	for (int i = 0; i < AGENTS_PER_PROC; i++) {
+		AgentId id(i, rank, 0);
+		model.context.addAgent(new ExchangeAgent(id, 0));
+		model.grid->moveTo(id, Point<int>(base + i, i));
+		local.insert(id);
+	}
+	checkPushes(model.grid, local);
+
+	// Into the interior, into the buffer strip, and out of bounds
+	model.grid->moveTo(AgentId(0, rank, 0), Point<int>(base + 2, 0));
+	model.grid->moveTo(AgentId(2, rank, 0), Point<int>(base + AGENTS_PER_PROC - 1, 2));
+	model.grid->moveTo(AgentId(3, rank, 0), Point<int>(base + AGENTS_PER_PROC, 3));
+	checkPushes(model.grid, local);
+
+	// Several moves between pushes, with only the last one counting, and a removal
+	model.grid->moveTo(AgentId(4, rank, 0), Point<int>(base, 4));
+	model.grid->moveTo(AgentId(4, rank, 0), Point<int>(base + AGENTS_PER_PROC, 4));
+	model.grid->moveTo(AgentId(4, rank, 0), Point<int>(base + AGENTS_PER_PROC - 1, 4));
+	model.grid->moveTo(AgentId(2, rank, 0), Point<int>(base, 2));
+	model.grid->moveTo(AgentId(2, rank, 0), Point<int>(base + 5, 2));
+	model.context.removeAgent(AgentId(AGENTS_PER_PROC - 1, rank, 0));
+	checkPushes(model.grid, local);
+}
@@ -40,9 +40,11 @@
  */
 
 #include "repast_hpc/Context.h"
+#include "repast_hpc/SharedContext.h"
 #include "repast_hpc/Graph.h"
 #include "repast_hpc/ValueLayer.h"
 #include "repast_hpc/GridComponents.h"
+#include "repast_hpc/AgentIdSet.h"
 
 #include "test.h"
 
@@ -1030,6 +1032,72 @@ TEST_F(ContextTest, AgentSelection_Basic)
 
 
 
+TEST_F(ContextTest, RandomAgents)
+{
+	for(int i = 0; i < 1000; i++){
+		TestAgent* agent = new TestAgent(i, 0, 0);
+		context.addAgent(agent);
+	}
+	// Remove every other agent so the dense index has been swap-compacted
+	for(int i = 0; i < 1000; i += 2) context.removeAgent(AgentId(i, 0, 0));
+	ASSERT_EQ(500, context.size());
+
+	vector<TestAgent*> agents;
+	context.getRandomAgents(100, agents);
+	ASSERT_EQ(100, agents.size());
+	set<TestAgent*> unique(agents.begin(), agents.end());
+	ASSERT_EQ(100, unique.size());
+	for(vector<TestAgent*>::iterator iter = agents.begin(); iter != agents.end(); ++iter){
+		ASSERT_TRUE(context.contains((*iter)->getId()));
+		ASSERT_EQ(1, (*iter)->getId().id() % 2);
+	}
+
+	// Agents already in the vector are not drawn again
+	context.getRandomAgents(100, agents);
+	ASSERT_EQ(200, agents.size());
+	unique.insert(agents.begin(), agents.end());
+	ASSERT_EQ(200, unique.size());
+
+	// Asking for more than are available returns all of them
+	agents.clear();
+	context.getRandomAgents(600, agents);
+	ASSERT_EQ(500, agents.size());
+}
+
+TEST_F(ContextTest, SharedAgentSelection)
+{
+	boost::mpi::communicator world;
+	SharedContext<TestAgent> shared(&world);
+	int rank = world.rank();
+	int other = rank + 1;
+	for(int i = 0; i < 1000; i++){
+		shared.addAgent(new TestAgent(i, (i % 4 == 0 ? other : rank), i % 2));
+	}
+
+	vector<TestAgent*> agents;
+	shared.selectAgents(SharedContext<TestAgent>::LOCAL, 100, agents);
+	ASSERT_EQ(100, agents.size());
+	for(vector<TestAgent*>::iterator iter = agents.begin(); iter != agents.end(); ++iter) ASSERT_EQ(rank, (*iter)->getId().currentRank());
+
+	set<TestAgent*> nonLocal;
+	shared.selectAgents(SharedContext<TestAgent>::NON_LOCAL, 1000, nonLocal);
+	ASSERT_EQ(250, nonLocal.size());
+	for(set<TestAgent*>::iterator iter = nonLocal.begin(); iter != nonLocal.end(); ++iter) ASSERT_EQ(other, (*iter)->getId().currentRank());
+
+	// Local agents of type 1: every odd id
+	agents.clear();
+	shared.selectAgents(SharedContext<TestAgent>::LOCAL, 1000, agents, 1);
+	ASSERT_EQ(500, agents.size());
+	set<TestAgent*> unique(agents.begin(), agents.end());
+	ASSERT_EQ(500, unique.size());
+	for(vector<TestAgent*>::iterator iter = agents.begin(); iter != agents.end(); ++iter) ASSERT_EQ(1, (*iter)->getId().agentType());
+
+	// Local agents of type 0: ids divisible by 2 but not 4
+	set<TestAgent*> typeZero;
+	shared.selectAgents(SharedContext<TestAgent>::LOCAL, 1000, typeZero, 0);
+	ASSERT_EQ(250, typeZero.size());
+}
+
 TEST_F(ContextTest, AgentSelection_ByType){
 
 	for(int i = 0; i < 1000; i++){
@@ -1363,3 +1431,48 @@ TEST_F(ContextTest, AgentSelection_Filtered_ByType){
 		
 	}
 }
+
+TEST(AgentIdSet, All) {
+	AgentIdSet ids;
+	std::set<AgentId> expected;
+	ASSERT_TRUE(ids.empty());
+
+	// out of order, with duplicates and ids of another type
+	for (int i = 0; i < 200; i++) {
+		AgentId id((i * 37) % 100, 0, i % 2);
+		ids.insert(id);
+		expected.insert(id);
+	}
+	ASSERT_EQ(expected.size(), ids.size());
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), ids.begin()));
+
+	// duplicates differing only in current rank
+	ids.insert(AgentId(3, 0, 1, 5));
+	ASSERT_EQ(expected.size(), ids.size());
+	ASSERT_TRUE(ids.contains(AgentId(3, 0, 1)));
+	ASSERT_FALSE(ids.contains(AgentId(3, 1, 1)));
+	ASSERT_EQ(1, ids.count(AgentId(99, 0, 1)));
+	ASSERT_EQ(0, ids.count(AgentId(99, 0, 0)));
+	ASSERT_TRUE(ids.find(AgentId(100, 0, 0)) == ids.end());
+	ASSERT_TRUE(*ids.find(AgentId(41, 0, 1)) == AgentId(41, 0, 1));
+
+	ids.erase(AgentId(41, 0, 1));
+	expected.erase(AgentId(41, 0, 1));
+	ASSERT_FALSE(ids.contains(AgentId(41, 0, 1)));
+
+	AgentIdSet evens;
+	for (int i = 98; i >= 0; i -= 2) {
+		evens.insert(AgentId(i, 0, 0));
+		expected.erase(AgentId(i, 0, 0));
+	}
+	evens.insert(AgentId(500, 0, 0));
+	ids.erase(evens);
+	ASSERT_EQ(expected.size(), ids.size());
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), ids.begin()));
+
+	ids.clear();
+	ASSERT_TRUE(ids.empty());
+	ASSERT_EQ(0, ids.size());
+	ids.insert(AgentId(1, 0, 0));
+	ASSERT_EQ(1, ids.size());
+}
@@ -588,4 +588,65 @@ TEST_F(Errors, Repast_Error_57) {
     ASSERT_TRUE(string(e.what()).size() > 0);
   }
 }
+TEST_F(Errors, Repast_Error_58) {
+  Repast_Error_58 r_error(2, 1);
+  ASSERT_TRUE(string(r_error.what()).size() > 0);
+  try {
+    throw r_error;
+    FAIL();
+  } catch (std::exception& e) {
+    ASSERT_TRUE(string(e.what()).size() > 0);
+  }
+}
+TEST_F(Errors, Repast_Error_59) {
+  Repast_Error_59 r_error("0");
+  ASSERT_TRUE(string(r_error.what()).size() > 0);
+  try {
+    throw r_error;
+    FAIL();
+  } catch (std::exception& e) {
+    ASSERT_TRUE(string(e.what()).size() > 0);
+  }
+}
+TEST_F(Errors, Repast_Error_60) {
+  Repast_Error_60 r_error;
+  ASSERT_TRUE(string(r_error.what()).size() > 0);
+  try {
+    throw r_error;
+    FAIL();
+  } catch (std::exception& e) {
+    ASSERT_TRUE(string(e.what()).size() > 0);
+  }
+}
+TEST_F(Errors, Repast_Error_61) {
+  Repast_Error_61 r_error("threefry");
+  ASSERT_TRUE(string(r_error.what()).size() > 0);
+  try {
+    throw r_error;
+    FAIL();
+  } catch (std::exception& e) {
+    ASSERT_TRUE(string(e.what()).size() > 0);
+  }
+}
+
+TEST_F(Errors, Repast_Error_62) {
+  Repast_Error_62 r_error(3, 2);
+  ASSERT_TRUE(string(r_error.what()).size() > 0);
+  try {
+    throw r_error;
+    FAIL();
+  } catch (std::exception& e) {
+    ASSERT_TRUE(string(e.what()).size() > 0);
+  }
+}
 
+TEST_F(Errors, Repast_Error_63) {
+  Repast_Error_63 r_error(3, 2);
+  ASSERT_TRUE(string(r_error.what()).size() > 0);
+  try {
+    throw r_error;
+    FAIL();
+  } catch (std::exception& e) {
+    ASSERT_TRUE(string(e.what()).size() > 0);
+  }
+}
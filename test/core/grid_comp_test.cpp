@@ -42,6 +42,8 @@
 #include "repast_hpc/GridComponents.h"
 #include "repast_hpc/MultipleOccupancy.h"
 #include "repast_hpc/SingleOccupancy.h"
+#include "repast_hpc/DenseMultipleOccupancy.h"
+#include "repast_hpc/BinnedMultipleOccupancy.h"
 #include "test.h"
 
 #include <gtest/gtest.h>
@@ -100,6 +102,33 @@ TEST(WrapAroundBorders, Transform)
 
 }
 
+TEST(WrapAroundBorders, TransformFixedPoint)
+{
+	WrapAroundBorders borders(GridDimensions(Point<double>(-4, 1), Point<double>(10, 51)));
+
+	int input[] = {16, 8, 10, 14, 2, -3, 5, -15, -11, -13, -14};
+	for (int i = 0; i < 11; i++) {
+		vector<int> in(2, input[i]), out(2, 0);
+		borders.transform(in, out);
+
+		Point<int, 2> fixed;
+		borders.transform(Point<int, 2>(input[i], input[i]), fixed);
+		ASSERT_EQ(out, vector<int>(fixed.begin(), fixed.end()));
+
+		Point<int, 2> translated;
+		borders.translate(Point<int, 2>(input[i], 0), translated, Point<int, 2>(0, input[i]));
+		ASSERT_EQ(fixed, translated);
+	}
+
+	vector<double> in2(2, 9.06), out2(2, 0);
+	in2[1] = 0.93934;
+	borders.transform(in2, out2);
+	Point<double, 2> wrapped;
+	borders.transform(Point<double, 2>(9.06, 0.93934), wrapped);
+	ASSERT_EQ(out2[0], wrapped[0]);
+	ASSERT_EQ(out2[1], wrapped[1]);
+}
+
 TEST(StickyBorders, Translate)
 {
 	GridDimensions dimensions(Point<double> (5, 8));
@@ -271,3 +300,110 @@ TEST(MultipleOccupancy, All)
 	mo.put(agents[2], pt);
 	ASSERT_EQ(agents[2].get(), mo.get(pt));
 }
+
+TEST(DenseMultipleOccupancy, All)
+{
+	DenseMultipleOccupancy<TestAgent, int, 2> dense;
+	dense.init(GridDimensions(Point<double>(-2, 0), Point<double>(4, 3)));
+	ASSERT_EQ(12, dense.cellCount());
+
+	vector<boost::shared_ptr<TestAgent> > agents;
+	for (int i = 0; i < 6; i++) {
+		agents.push_back(boost::shared_ptr<TestAgent>(new TestAgent(i, 0, 0)));
+	}
+
+	// inside the cell array, occupants come back in the order they arrived
+	Point<int, 2> inside(-1, 2);
+	ASSERT_TRUE(dense.get(inside) == NULL);
+	for (int i = 0; i < 3; i++) ASSERT_TRUE(dense.put(agents[i], inside));
+	ASSERT_EQ(agents[0].get(), dense.get(Point<int>(-1, 2)));
+
+	vector<TestAgent*> vec;
+	dense.getAll(inside, vec);
+	ASSERT_EQ(3, vec.size());
+	for (int i = 0; i < 3; i++) ASSERT_EQ(agents[i].get(), vec[i]);
+
+	dense.remove(agents[1], inside);
+	vec.clear();
+	dense.getAll(inside, vec);
+	ASSERT_EQ(2, vec.size());
+	ASSERT_EQ(agents[0].get(), vec[0]);
+	ASSERT_EQ(agents[2].get(), vec[1]);
+
+	// outside the cell array, locations fall back to the overflow map
+	Point<int, 2> outside(2, 0);
+	ASSERT_TRUE(dense.put(agents[3], outside));
+	ASSERT_TRUE(dense.put(agents[4], Point<int>(2, 0)));
+	vec.clear();
+	dense.getAll(outside, vec);
+	ASSERT_EQ(2, vec.size());
+	dense.remove(agents[3], outside);
+	dense.remove(agents[4], outside);
+	ASSERT_TRUE(dense.get(outside) == NULL);
+
+	vec.clear();
+	dense.getAll(Point<int, 2>(-2, 0), vec);
+	ASSERT_EQ(0, vec.size());
+}
+
+namespace {
+
+struct CollectBoxed {
+	vector<TestAgent*> agents;
+
+	void operator()(TestAgent* agent, const Point<double, 2>& location) {
+		agents.push_back(agent);
+	}
+};
+
+}
+
+TEST(BinnedMultipleOccupancy, All)
+{
+	BinnedMultipleOccupancy<TestAgent, double, 2> binned;
+	binned.init(GridDimensions(Point<double>(0, 0), Point<double>(10, 10)));
+	ASSERT_EQ(100, binned.binCount());
+
+	vector<boost::shared_ptr<TestAgent> > agents;
+	for (int i = 0; i < 4; i++) {
+		agents.push_back(boost::shared_ptr<TestAgent>(new TestAgent(i, 0, 0)));
+	}
+
+	// two agents share a bin but not a location
+	ASSERT_TRUE(binned.put(agents[0], Point<double, 2>(1.25, 1.5)));
+	ASSERT_TRUE(binned.put(agents[1], Point<double, 2>(1.75, 1.5)));
+	ASSERT_EQ(agents[0].get(), binned.get(Point<double>(1.25, 1.5)));
+	vector<TestAgent*> vec;
+	binned.getAll(Point<double, 2>(1.75, 1.5), vec);
+	ASSERT_EQ(1, vec.size());
+	ASSERT_EQ(agents[1].get(), vec[0]);
+
+	// outside the bin array, e.g. a buffer zone agent across the border
+	ASSERT_TRUE(binned.put(agents[2], Point<double, 2>(-0.5, 3)));
+	ASSERT_TRUE(binned.put(agents[3], Point<double, 2>(12, 12)));
+	ASSERT_EQ(agents[2].get(), binned.get(Point<double, 2>(-0.5, 3)));
+
+	vector<double> lower(2, -1), upper(2, 3);
+	CollectBoxed boxed;
+	binned.visitBox(lower, upper, boxed);
+	ASSERT_EQ(3, boxed.agents.size());
+
+	lower[0] = 1.5;
+	boxed.agents.clear();
+	binned.visitBox(lower, upper, boxed);
+	ASSERT_EQ(1, boxed.agents.size());
+	ASSERT_EQ(agents[1].get(), boxed.agents[0]);
+
+	binned.remove(agents[2], Point<double, 2>(-0.5, 3));
+	ASSERT_TRUE(binned.get(Point<double, 2>(-0.5, 3)) == NULL);
+
+	// rebinning keeps every agent
+	binned.setBinWidth(5);
+	ASSERT_EQ(4, binned.binCount());
+	lower.assign(2, 0);
+	upper.assign(2, 20);
+	boxed.agents.clear();
+	binned.visitBox(lower, upper, boxed);
+	ASSERT_EQ(3, boxed.agents.size());
+	ASSERT_EQ(agents[3].get(), binned.get(Point<double, 2>(12, 12)));
+}
@@ -40,6 +40,8 @@
  */
 
 #include "repast_hpc/Spaces.h"
+#include "repast_hpc/SharedSpaces.h"
+#include "repast_hpc/SharedContext.h"
 #include "repast_hpc/Context.h"
 #include "repast_hpc/Moore2DGridQuery.h"
 #include "repast_hpc/VN2DGridQuery.h"
@@ -50,6 +52,8 @@
 using namespace repast;
 using namespace std;
 
+typedef Point<int, 2> Point2;
+
 TEST(GridTest, GridFill)
 {
 	Context<TestAgent> context;
@@ -687,3 +691,147 @@ TEST(GridTest, VNQueries)
 
 }
 
+TEST(GridTest, FixedPoint)
+{
+	Point2 fixed(3, -7);
+	Point<int> dynamic(3, -7);
+	size_t fixedHash = HashGridPoint<int, 2>()(fixed);
+	ASSERT_EQ(HashGridPoint<int>()(dynamic), fixedHash);
+	ASSERT_TRUE(EqualGridPoint()(fixed, dynamic));
+	ASSERT_TRUE(EqualGridPoint()(fixed, dynamic.coords()));
+	ASSERT_FALSE(EqualGridPoint()(fixed, Point<int>(3, -7, 0)));
+
+	ASSERT_EQ(dynamic, Point<int>(fixed));
+	ASSERT_EQ(fixed, Point2(dynamic));
+	ASSERT_EQ(2, fixed.dimensionCount());
+	ASSERT_EQ(-7, fixed.getY());
+
+	Point<int> assigned(0);
+	assigned = fixed;
+	ASSERT_EQ(dynamic, assigned);
+	ASSERT_EQ(HashGridPoint<int>()(dynamic), HashGridPoint<int>()(assigned));
+
+	fixed.add(Point2(1, 1));
+	ASSERT_EQ(Point2(4, -6), fixed);
+	ASSERT_TRUE(Point2(4, -7) < fixed);
+
+	ASSERT_THROW((Point2(std::vector<int>(3, 0))), Repast_Error_62);
+}
+
+TEST(GridTest, FixedPointGrid)
+{
+	Context<TestAgent> context;
+
+	GridDimensions dims(Point<double> (-5, 0), Point<double> (10, 10));
+	Spaces<TestAgent>::MultipleWrappedDiscreteSpace2D* fixedGrid = new Spaces<TestAgent>::MultipleWrappedDiscreteSpace2D("fixed", dims);
+	Spaces<TestAgent>::MultipleWrappedDiscreteSpace* dynamicGrid = new Spaces<TestAgent>::MultipleWrappedDiscreteSpace("dynamic", dims);
+	context.addProjection(fixedGrid);
+	context.addProjection(dynamicGrid);
+
+	for (int i = 0; i < 40; i++) {
+		context.addAgent(new TestAgent(i, 0, 0));
+	}
+
+	// moves through the fixed and dynamic paths must agree, including wrapping
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < 40; i++) {
+			int x = (i * 7 + round * 5) % 23 - 11;
+			int y = (i * 3 + round * 11) % 29 - 9;
+			ASSERT_TRUE(fixedGrid->moveTo(AgentId(i, 0, 0), Point2 (x, y)));
+			ASSERT_TRUE(dynamicGrid->moveTo(AgentId(i, 0, 0), Point<int> (x, y)));
+		}
+
+		for (int i = 0; i < 40; i++) {
+			std::vector<int> fixedLoc, dynamicLoc;
+			ASSERT_TRUE(fixedGrid->getLocation(AgentId(i, 0, 0), fixedLoc));
+			ASSERT_TRUE(dynamicGrid->getLocation(AgentId(i, 0, 0), dynamicLoc));
+			ASSERT_EQ(dynamicLoc, fixedLoc);
+
+			Point2 pt;
+			ASSERT_TRUE(fixedGrid->getLocation(AgentId(i, 0, 0), pt));
+			ASSERT_EQ(Point2 (dynamicLoc), pt);
+		}
+
+		Moore2DGridQuery<TestAgent> fixedQuery(fixedGrid);
+		Moore2DGridQuery<TestAgent> dynamicQuery(dynamicGrid);
+		for (int x = -5; x < 5; x++) {
+			for (int y = 0; y < 10; y++) {
+				std::vector<TestAgent*> fixedOut, dynamicOut, dynamicAt, fixedAt;
+				fixedQuery.query(Point<int> (x, y), 1, true, fixedOut);
+				dynamicQuery.query(Point<int> (x, y), 1, true, dynamicOut);
+				std::sort(fixedOut.begin(), fixedOut.end());
+				std::sort(dynamicOut.begin(), dynamicOut.end());
+				ASSERT_EQ(dynamicOut, fixedOut);
+
+				// a dynamic grid answers fixed point lookups too
+				fixedGrid->getObjectsAt(Point<int> (x, y), fixedAt);
+				dynamicGrid->getObjectsAt(Point2 (x, y), dynamicAt);
+				ASSERT_EQ(fixedAt.size(), dynamicAt.size());
+			}
+		}
+	}
+	ASSERT_EQ(40, fixedGrid->size());
+}
+
+TEST(GridTest, IndexedSpaceQueries)
+{
+	boost::mpi::communicator* comm = RepastProcess::instance()->getCommunicator();
+	int rank = comm->rank();
+	SharedContext<TestAgent> context(comm);
+
+	// one 10 x 10 column per process, wrapping in both dimensions
+	vector<int> processDims;
+	processDims.push_back(comm->size());
+	processDims.push_back(1);
+	GridDimensions dims(Point<double> (0, 0), Point<double> (comm->size() * 10, 10));
+	SharedSpaces<TestAgent>::SharedWrappedIndexedContinuousSpace* space =
+			new SharedSpaces<TestAgent>::SharedWrappedIndexedContinuousSpace("space", dims, processDims, 0, comm);
+	context.addProjection(space);
+
+	double x = rank * 10;
+	double coords[][2] = { { x + 5, 0.5 }, { x + 5, 9.5 }, { x + 6, 9.8 }, { x + 2, 5 }, { x + 8, 5 }, { x + 5, 5 } };
+	vector<TestAgent*> agents;
+	for (int i = 0; i < 6; i++) {
+		TestAgent* agent = new TestAgent(i, rank, 0);
+		agents.push_back(agent);
+		context.addAgent(agent);
+		space->moveTo(agent->getId(), Point<double, 2> (coords[i][0], coords[i][1]));
+	}
+
+	// the radius reaches across the y border
+	vector<TestAgent*> out;
+	space->queryRadius(Point<double, 2> (x + 5, 0.2), 0.9, out);
+	ASSERT_EQ(2, out.size());
+	ASSERT_TRUE(find(out.begin(), out.end(), agents[0]) != out.end());
+	ASSERT_TRUE(find(out.begin(), out.end(), agents[1]) != out.end());
+
+	out.clear();
+	space->queryBox(Point<double, 2> (x + 1, 4), Point<double, 2> (x + 5, 6), out);
+	ASSERT_EQ(2, out.size());
+	ASSERT_TRUE(find(out.begin(), out.end(), agents[3]) != out.end());
+	ASSERT_TRUE(find(out.begin(), out.end(), agents[5]) != out.end());
+
+	// the box wraps from y 9 to y 1
+	out.clear();
+	space->queryBox(Point<double, 2> (x + 4, 9), Point<double, 2> (x + 6, 11), out);
+	ASSERT_EQ(3, out.size());
+
+	out.clear();
+	space->kNearest(Point<double, 2> (x + 5, 5.5), 3, out);
+	ASSERT_EQ(3, out.size());
+	ASSERT_EQ(agents[5], out[0]);
+	ASSERT_EQ(agents[3], out[1]);
+	ASSERT_EQ(agents[4], out[2]);
+
+	// moves keep the index up to date
+	space->moveTo(agents[5]->getId(), Point<double, 2> (x + 5, 1));
+	out.clear();
+	space->queryRadius(Point<double, 2> (x + 5, 0.2), 0.9, out);
+	ASSERT_EQ(3, out.size());
+
+	space->setQueryBinWidth(4);
+	out.clear();
+	space->kNearest(Point<double, 2> (x + 5, 5.5), 10, out);
+	ASSERT_EQ(6, out.size());
+	ASSERT_EQ(agents[3], out[0]);
+}
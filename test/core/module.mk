@@ -1,17 +1,18 @@
-SOURCES = context_test.cpp \
+SOURCES = agent_exchange_test.cpp \
+          context_test.cpp \
           grid_comp_test.cpp \
+          grid_test.cpp \
           main.cpp \
+          parallel_agents_test.cpp \
           properties_test.cpp \
           random_test.cpp \
           schedule_test.cpp \
+          sr_manager_test.cpp \
+          value_layer_nd_test.cpp \
           value_layer_tests.cpp 
 
 local_dir := core
 local_src :=  $(addprefix $(local_dir)/, $(SOURCES))
 core_test_src += $(local_src)
 
-# broken tests
-# grid_test.cpp
-
-
 
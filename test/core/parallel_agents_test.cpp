@@ -0,0 +1,254 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * parallel_agents_test.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Checks the Philox4x32 engine against the published known-answer vectors,
+ *  and that parallel agent loops (Context::parallelForEach, relogo's
+ *  AgentSet::askParallel) with per-agent random streams and deferred grid
+ *  moves give the same results for any thread count.
+ */
+
+#include "repast_hpc/RandomStream.h"
+#include "repast_hpc/ParallelAgents.h"
+#include "repast_hpc/Context.h"
+#include "relogo/AgentSet.h"
+
+#include <gtest/gtest.h>
+#include <boost/random/normal_distribution.hpp>
+#include <vector>
+#include <map>
+
+using namespace repast;
+using namespace std;
+
+namespace {
+
+const int AGENT_COUNT = 500;
+const int GRID_WIDTH = 30;
+
+class StepAgent {
+
+private:
+	AgentId id_;
+
+public:
+	double draw;
+	int target[2];
+
+	StepAgent(int id, int proc) : id_(id, proc, 0), draw(0) {
+		target[0] = target[1] = 0;
+	}
+
+	const AgentId& getId() const {
+		return id_;
+	}
+
+	void step() {
+		RandomStream& random = agentRandom();
+		draw = random.nextDouble();
+		target[0] = random.nextInt(0, GRID_WIDTH - 1);
+		target[1] = random.nextInt(0, GRID_WIDTH - 1);
+	}
+};
+
+struct Step {
+	void operator()(StepAgent* agent) const {
+		agent->step();
+	}
+};
+
+struct StepAndMove {
+	DeferredMoves<int>* moves;
+
+	void operator()(StepAgent* agent) const {
+		agent->step();
+		vector<int> location(agent->target, agent->target + 2);
+		moves->moveTo(agent->getId(), location);
+	}
+};
+
+/**
+ * Single occupancy grid: a move into an occupied cell fails.
+ */
+class CellGrid {
+
+private:
+	map<vector<int>, AgentId> occupants;
+	map<AgentId, vector<int> > locations;
+
+public:
+	bool moveTo(const AgentId& id, const vector<int>& location) {
+		if (occupants.find(location) != occupants.end()) return false;
+		map<AgentId, vector<int> >::iterator current = locations.find(id);
+		if (current != locations.end()) occupants.erase(current->second);
+		occupants[location] = id;
+		locations[id] = location;
+		return true;
+	}
+
+	bool getLocation(const AgentId& id, vector<int>& out) const {
+		map<AgentId, vector<int> >::const_iterator current = locations.find(id);
+		if (current == locations.end()) return false;
+		out = current->second;
+		return true;
+	}
+};
+
+/**
+ * Runs the context's agents through two parallel loops with the specified
+ * thread count, and returns their draws and locations in agent id order.
+ */
+void runContext(int threads, vector<double>& draws, vector<int>& locations) {
+	Random::initialize(42);
+	setThreadCount(threads);
+	Context<StepAgent> context;
+	CellGrid grid;
+	vector<StepAgent*> agents;
+	for (int i = 0; i < AGENT_COUNT; i++) agents.push_back(context.addAgent(new StepAgent(i, 0)));
+
+	DeferredMoves<int> moves;
+	StepAndMove stepAndMove;
+	stepAndMove.moves = &moves;
+	for (int loop = 0; loop < 2; loop++) {
+		context.parallelForEach(stepAndMove);
+		ASSERT_EQ((size_t) AGENT_COUNT, moves.size());
+		moves.apply(grid);
+	}
+	setThreadCount(1);
+
+	draws.clear();
+	locations.clear();
+	for (size_t i = 0; i < agents.size(); i++) {
+		draws.push_back(agents[i]->draw);
+		vector<int> location;
+		if (grid.getLocation(agents[i]->getId(), location)) locations.insert(locations.end(), location.begin(), location.end());
+		else locations.push_back(-1);
+	}
+}
+
+}
+
+TEST(Philox4x32, KnownAnswers)
+{
+	// From the Random123 known-answer tests (kat_vectors)
+	uint32_t counters[3][4] = { { 0, 0, 0, 0 }, { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+			{ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 } };
+	uint32_t keys[3][2] = { { 0, 0 }, { 0xffffffff, 0xffffffff }, { 0xa4093822, 0x299f31d0 } };
+	uint32_t expected[3][4] = { { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 },
+			{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd }, { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } };
+	for (int i = 0; i < 3; i++) {
+		uint32_t out[4];
+		Philox4x32::block(counters[i], keys[i], out);
+		for (int j = 0; j < 4; j++) ASSERT_EQ(expected[i][j], out[j]);
+	}
+}
+
+TEST(Philox4x32, Streams)
+{
+	Philox4x32 engine(7, 3);
+	Philox4x32 skipped(7, 3);
+	Philox4x32 other(7, 4);
+	vector<uint32_t> values;
+	for (int i = 0; i < 11; i++) values.push_back(engine());
+	ASSERT_EQ(11u, engine.position());
+
+	for (int count = 0; count < 11; count++) {
+		skipped.seed(7, 3);
+		skipped.discard(count);
+		ASSERT_EQ(values[count], skipped());
+	}
+	bool differs = false;
+	for (int i = 0; i < 11; i++) differs = differs || (other() != values[i]);
+	ASSERT_TRUE(differs);
+
+	// Works with the boost distributions
+	RandomStream stream(7, 3);
+	boost::normal_distribution<> normal(0, 1);
+	double sum = 0;
+	for (int i = 0; i < 1000; i++) {
+		double val = stream.nextDouble();
+		ASSERT_TRUE(val >= 0 && val < 1);
+		sum += normal(stream.engine());
+	}
+	ASSERT_LT(fabs(sum / 1000), 0.2);
+}
+
+TEST(ParallelAgents, ContextThreadCountIndependent)
+{
+	vector<double> serialDraws, threadedDraws;
+	vector<int> serialLocations, threadedLocations;
+	runContext(1, serialDraws, serialLocations);
+	runContext(4, threadedDraws, threadedLocations);
+	ASSERT_EQ(serialDraws, threadedDraws);
+	ASSERT_EQ(serialLocations, threadedLocations);
+
+	// Single occupancy: the later movers into a taken cell stay where they were
+	int placed = 0;
+	for (size_t i = 0; i < serialLocations.size(); i += 2) placed += (serialLocations[i] >= 0);
+	ASSERT_LT(placed, AGENT_COUNT);
+	ASSERT_GT(placed, AGENT_COUNT / 2);
+}
+
+TEST(ParallelAgents, AgentSetStreams)
+{
+	vector<StepAgent*> agents;
+	for (int i = 0; i < AGENT_COUNT; i++) agents.push_back(new StepAgent(i, 1));
+	relogo::AgentSet<StepAgent> set(agents.begin(), agents.end());
+
+	Random::initialize(42);
+	set.askParallel(&StepAgent::step);
+	vector<double> first;
+	for (int i = 0; i < AGENT_COUNT; i++) first.push_back(agents[i]->draw);
+
+	// Same seed and round, more threads, other order and other method of calling
+	Random::initialize(42);
+	setThreadCount(3);
+	relogo::AgentSet<StepAgent> reversed(agents.rbegin(), agents.rend());
+	reversed.applyParallel(Step());
+	setThreadCount(1);
+	for (int i = 0; i < AGENT_COUNT; i++) ASSERT_EQ(first[i], agents[i]->draw);
+
+	// Next round draws new streams
+	set.askParallel(&StepAgent::step);
+	int same = 0;
+	for (int i = 0; i < AGENT_COUNT; i++) same += (first[i] == agents[i]->draw);
+	ASSERT_EQ(0, same);
+
+	ASSERT_THROW(agentRandom(), Repast_Error_60);
+	ASSERT_EQ(-1, parallelAgentIndex());
+	for (size_t i = 0; i < agents.size(); i++) delete agents[i];
+}
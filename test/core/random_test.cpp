@@ -33,11 +33,14 @@
 */
 
 #include <fstream>
+#include <sstream>
 #include <gtest/gtest.h>
 
 #include "repast_hpc/Random.h"
 #include "repast_hpc/Properties.h"
 #include "repast_hpc/initialize_random.h"
+#include "repast_hpc/AgentId.h"
+#include "repast_hpc/RepastErrors.h"
 
 #include <typeinfo>
 
@@ -207,3 +210,61 @@ TEST(Random, DistFromProps)
     nGen->next();
 
 }
+
+TEST(Random, PhiloxFromProps)
+{
+    Properties props = Properties();
+    props.putProperty("random.seed", "123");
+    props.putProperty("random.engine", "philox");
+    props.putProperty("distribution.int_uni", "int_uniform, 3, 10");
+    initializeRandom(props);
+
+    Random* random = Random::instance();
+    ASSERT_EQ(RandomEngine::PHILOX, random->engine().type());
+    ASSERT_EQ(123u, random->seed());
+    NumberGenerator* nGen = random->getGenerator("int_uni");
+    for (int i = 0; i < 1000; i++) {
+        double val = nGen->next();
+        ASSERT_TRUE(val >= 3 && val <= 10);
+    }
+
+    // Save and restore the engine state
+    std::stringstream saved;
+    saved << random->engine();
+    std::vector<double> expected;
+    for (int i = 0; i < 50; i++) expected.push_back(random->nextDouble());
+    RandomEngine engine(0, RandomEngine::PHILOX);
+    saved >> engine;
+    Random::initialize(engine);
+    for (int i = 0; i < 50; i++) ASSERT_EQ(expected[i], Random::instance()->nextDouble());
+
+    props.putProperty("random.engine", "mt19937");
+    initializeRandom(props);
+    ASSERT_EQ(RandomEngine::MT19937, Random::instance()->engine().type());
+
+    props.putProperty("random.engine", "threefry");
+    ASSERT_THROW(initializeRandom(props), Repast_Error_61);
+}
+
+TEST(Random, CreateStream)
+{
+    AgentId id(5, 1, 2), other(5, 1, 3);
+    Random::initialize(77);
+    RandomStream stream = Random::instance()->createStream(id, 3, 1);
+    std::vector<double> expected;
+    for (int i = 0; i < 20; i++) expected.push_back(stream.nextDouble());
+
+    // Independent of the engine, of earlier draws and of the agent's current rank
+    Random::initialize(77, RandomEngine::PHILOX);
+    for (int i = 0; i < 100; i++) Random::instance()->nextDouble();
+    id.currentRank(4);
+    stream = Random::instance()->createStream(id, 3, 1);
+    for (int i = 0; i < 20; i++) ASSERT_EQ(expected[i], stream.nextDouble());
+
+    // Any change of key gives another stream
+    RandomStream streams[] = { Random::instance()->createStream(other, 3, 1), Random::instance()->createStream(id, 4, 1),
+            Random::instance()->createStream(id, 3, 2), Random::instance()->createStream(1, 3, 1) };
+    for (int i = 0; i < 4; i++) ASSERT_NE(expected[0], streams[i].nextDouble());
+    Random::initialize(78);
+    ASSERT_NE(expected[0], Random::instance()->createStream(id, 3, 1).nextDouble());
+}
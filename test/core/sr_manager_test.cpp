@@ -0,0 +1,102 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * sr_manager_test.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Checks that every SRManager engine finds the same sources. Run under
+ *  mpirun with several processes to exercise the exchange.
+ */
+
+#include "repast_hpc/SRManager.h"
+
+#include <gtest/gtest.h>
+#include <boost/mpi.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Process p sends to p + 1, p + 3 and, if p is even, to 0
+void getTargets(int rank, int size, vector<int>& targets) {
+	targets.clear();
+	int candidates[] = { (rank + 1) % size, (rank + 3) % size, (rank % 2 == 0 ? 0 : rank) };
+	for (int i = 0; i < 3; i++) {
+		if (candidates[i] != rank && find(targets.begin(), targets.end(), candidates[i]) == targets.end()) targets.push_back(candidates[i]);
+	}
+}
+
+void checkEngine(SRManager::Engine engine) {
+	boost::mpi::communicator world;
+	int rank = world.rank();
+	int size = world.size();
+
+	vector<int> expected;
+	vector<int> targets;
+	for (int p = 0; p < size; p++) {
+		getTargets(p, size, targets);
+		if (find(targets.begin(), targets.end(), rank) != targets.end()) expected.push_back(p);
+	}
+
+	getTargets(rank, size, targets);
+	// Repeat to check that successive exchanges do not interfere
+	for (int i = 0; i < 3; i++) {
+		SRManager manager(&world, engine);
+		vector<int> sources;
+		manager.retrieveSources(targets, sources);
+		sort(sources.begin(), sources.end());
+		ASSERT_EQ(expected, sources);
+	}
+}
+
+}
+
+TEST(SRManager, Alltoall)
+{
+	checkEngine(SRManager::ALLTOALL);
+}
+
+TEST(SRManager, ReduceScatter)
+{
+	checkEngine(SRManager::REDUCE_SCATTER);
+}
+
+TEST(SRManager, NBX)
+{
+	checkEngine(SRManager::NBX);
+}
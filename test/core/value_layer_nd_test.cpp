@@ -0,0 +1,401 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*
+ * value_layer_nd_test.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *
+ *  Checks the synchronization of ValueLayerND and ValueLayerNDSU buffer
+ *  zones. Every process fills its local cells with a function of their
+ *  global coordinates, synchronizes, and checks that each buffer cell holds
+ *  the value of the cell it mirrors. The space is split across all processes,
+ *  so the tests exercise the exchange when run under mpirun (on one process
+ *  a periodic layer exchanges with itself). Also checks that the row-wise
+ *  DiffusionLayerND stencil path matches the per-cell diffusor path, and
+ *  that threaded layer operations match single-threaded ones.
+ */
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/ValueLayerND.h"
+#include "repast_hpc/DiffusionLayerND.h"
+#include "repast_hpc/initialize_threads.h"
+#include "repast_hpc/RepastErrors.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace repast;
+using namespace std;
+
+namespace {
+
+const int LOCAL_WIDTH = 6;
+
+vector<int> processDims(int dimCount) {
+	vector<int> dims(dimCount, 0);
+	MPI_Dims_create(RepastProcess::instance()->worldSize(), dimCount, &dims[0]);
+	return dims;
+}
+
+GridDimensions globalBounds(const vector<int>& procs) {
+	vector<double> origin(procs.size(), 0), extents;
+	for (size_t i = 0; i < procs.size(); i++)
+		extents.push_back(procs[i] * LOCAL_WIDTH);
+	return GridDimensions(Point<double>(origin), Point<double>(extents));
+}
+
+double cellValue(const vector<int>& coords, int round) {
+	double val = round * 1000000 + 1;
+	double place = 1;
+	for (size_t i = 0; i < coords.size(); i++, place *= 100)
+		val += coords[i] * place;
+	return val;
+}
+
+// Steps coords through the box [min, max); returns false when done
+bool nextCoords(vector<int>& coords, const vector<int>& min, const vector<int>& max) {
+	for (size_t i = 0; i < coords.size(); i++) {
+		if (++coords[i] < max[i]) return true;
+		coords[i] = min[i];
+	}
+	return false;
+}
+
+void localBox(AbstractValueLayerND<double>& layer, int buffer, vector<int>& min, vector<int>& max) {
+	const GridDimensions& local = layer.getLocalBoundaries();
+	min.clear();
+	max.clear();
+	for (size_t i = 0; i < local.dimensionCount(); i++) {
+		min.push_back(local.origin(i) - buffer);
+		max.push_back(local.origin(i) + local.extents(i) + buffer);
+	}
+}
+
+template<typename Layer>
+void fillLocal(Layer& layer, int round) {
+	vector<int> min, max;
+	localBox(layer, 0, min, max);
+	vector<int> coords = min;
+	bool err;
+	do {
+		layer.setValueAt(cellValue(coords, round), coords, err);
+	} while (nextCoords(coords, min, max));
+}
+
+/**
+ * Checks the local cells and the buffer zone. Buffer cells are addressed by
+ * their wrapped global coordinates; cells outside a non-periodic space are
+ * skipped.
+ */
+template<typename Layer>
+void checkBuffers(Layer& layer, const GridDimensions& global, int buffer, bool periodic,
+		int round) {
+	vector<int> min, max;
+	localBox(layer, buffer, min, max);
+	vector<int> coords = min;
+	bool err;
+	do {
+		vector<int> wrapped = coords;
+		bool inside = true;
+		for (size_t i = 0; i < coords.size(); i++) {
+			int width = global.extents(i);
+			if (coords[i] < 0 || coords[i] >= width) {
+				inside = false;
+				wrapped[i] = (coords[i] + width) % width;
+			}
+		}
+		if (!inside && !periodic) continue;
+		ASSERT_EQ(cellValue(wrapped, round), layer.getValueAt(wrapped, err));
+	} while (nextCoords(coords, min, max));
+}
+
+void checkSynchronize(int dimCount, int buffer, bool periodic) {
+	vector<int> procs = processDims(dimCount);
+	GridDimensions global = globalBounds(procs);
+	ValueLayerND<double> layer(procs, global, buffer, periodic, 0, -1);
+	// Repeated exchanges restart the same persistent requests
+	for (int round = 0; round < 3; round++) {
+		fillLocal(layer, round);
+		layer.synchronize();
+		checkBuffers(layer, global, buffer, periodic, round);
+	}
+}
+
+/**
+ * Synchronizes a layer with each exchange strategy and checks that both
+ * fill the edge and corner buffer cells with the same values.
+ */
+template<typename Layer>
+void compareExchanges(int dimCount, int buffer, bool periodic) {
+	vector<int> procs = processDims(dimCount);
+	GridDimensions global = globalBounds(procs);
+	Layer allNeighbors(procs, global, buffer, periodic, 0, -1, AbstractValueLayerND<double>::ALL_NEIGHBORS);
+	Layer dimensionOrdered(procs, global, buffer, periodic, 0, -1, AbstractValueLayerND<double>::DIMENSION_ORDERED);
+	ASSERT_EQ(AbstractValueLayerND<double>::DIMENSION_ORDERED, dimensionOrdered.getExchange());
+	ASSERT_LE(dimensionOrdered.getSynchronizeMessageCount(), allNeighbors.getSynchronizeMessageCount());
+	for (int round = 0; round < 2; round++) {
+		fillLocal(allNeighbors, round);
+		fillLocal(dimensionOrdered, round);
+		allNeighbors.synchronize();
+		dimensionOrdered.synchronize();
+		checkBuffers(allNeighbors, global, buffer, periodic, round);
+		checkBuffers(dimensionOrdered, global, buffer, periodic, round);
+	}
+}
+
+/**
+ * Diffuses one layer with the stencil as a Diffusor, and another with the
+ * row-wise stencil path, and checks that the local cells agree.
+ */
+template<typename Stencil>
+void compareDiffusion(int dimCount, bool periodic, Stencil& stencil) {
+	vector<int> procs = processDims(dimCount);
+	GridDimensions global = globalBounds(procs);
+	DiffusionLayerND<double> perCell(procs, global, 1, periodic, 0, 0);
+	DiffusionLayerND<double> rowWise(procs, global, 1, periodic, 0, 0);
+	fillLocal(perCell, 0);
+	fillLocal(rowWise, 0);
+	perCell.synchronize();
+	rowWise.synchronize();
+	for (int step = 0; step < 3; step++) {
+		perCell.diffuse(&stencil);
+		rowWise.diffuse(stencil);
+	}
+
+	vector<int> min, max;
+	localBox(perCell, 0, min, max);
+	vector<int> coords = min;
+	bool err;
+	do {
+		double expected = perCell.getValueAt(coords, err);
+		ASSERT_NEAR(expected, rowWise.getValueAt(coords, err), 1e-9 * expected);
+	} while (nextCoords(coords, min, max));
+}
+
+/**
+ * Initializes, copies and diffuses one layer on a single thread and another
+ * on several, and checks that the local cells are identical. At the edges
+ * of a non-periodic space the buffer zone keeps its initial value, which
+ * then diffuses into the local cells.
+ */
+template<typename Diffuse>
+void compareThreaded(int dimCount, bool periodic, Diffuse diffuse) {
+	vector<int> procs = processDims(dimCount);
+	GridDimensions global = globalBounds(procs);
+	DiffusionLayerND<double> serial(procs, global, 1, periodic, 0, 0);
+	DiffusionLayerND<double> threaded(procs, global, 1, periodic, 0, 0);
+	DiffusionLayerND<double>* layers[] = { &serial, &threaded };
+	vector<int> min, max;
+	localBox(serial, 0, min, max);
+	bool err;
+	for (int i = 0; i < 2; i++) {
+		setThreadCount(i == 0 ? 1 : 4);
+		DiffusionLayerND<double>& layer = *layers[i];
+		layer.initialize(5.0, 7.0);
+		vector<int> coords = min;
+		do {
+			ASSERT_EQ(5.0, layer.getValueAt(coords, err));
+		} while (nextCoords(coords, min, max));
+		fillLocal(layer, 0);
+		layer.copyCurrentToSecondary();
+		layer.switchValueLayer();
+		layer.synchronize();
+		for (int step = 0; step < 3; step++)
+			diffuse(layer);
+	}
+	setThreadCount(1);
+
+	vector<int> coords = min;
+	do {
+		ASSERT_EQ(serial.getValueAt(coords, err), threaded.getValueAt(coords, err));
+	} while (nextCoords(coords, min, max));
+}
+
+void diffuseMooreCells(DiffusionLayerND<double>& layer) {
+	MooreDiffusor<double> moore(layer.getLocalBoundaries().dimensionCount(), 0.6, 0.05);
+	layer.diffuse(&moore);
+}
+
+void diffuseMooreRows(DiffusionLayerND<double>& layer) {
+	MooreDiffusor<double> moore(layer.getLocalBoundaries().dimensionCount(), 0.6, 0.05);
+	layer.diffuse(moore);
+}
+
+template<typename Layer>
+void compareExchanges(int dimCount) {
+	for (int buffer = 1; buffer <= 2; buffer++) {
+		compareExchanges<Layer>(dimCount, buffer, true);
+		compareExchanges<Layer>(dimCount, buffer, false);
+	}
+}
+
+}
+
+TEST(ValueLayerNDSync, Synchronize2D)
+{
+	checkSynchronize(2, 1, true);
+	checkSynchronize(2, 2, false);
+}
+
+TEST(ValueLayerNDSync, Synchronize3D)
+{
+	checkSynchronize(3, 1, false);
+	checkSynchronize(3, 2, true);
+}
+
+TEST(ValueLayerNDSync, SwitchedBanks)
+{
+	vector<int> procs = processDims(2);
+	GridDimensions global = globalBounds(procs);
+	ValueLayerNDSU<double> layer(procs, global, 2, true, 0, -1);
+	// Each bank has its own persistent requests
+	for (int round = 0; round < 4; round++) {
+		fillLocal(layer, round);
+		layer.synchronize();
+		checkBuffers(layer, global, 2, true, round);
+		layer.switchValueLayer();
+	}
+}
+
+TEST(ValueLayerNDSync, ConcurrentLayers)
+{
+	// Layers created one after the other must not share message tags when
+	// their exchanges are in flight at the same time. Neighboring processes
+	// start the exchanges in opposite orders, so shared tags would mismatch.
+	vector<int> procs = processDims(2);
+	GridDimensions global = globalBounds(procs);
+	ValueLayerND<double> first(procs, global, 1, true, 0, -1);
+	ValueLayerND<double> second(procs, global, 1, true, 0, -1);
+	ValueLayerNDSU<double> third(procs, global, 1, true, 0, -1);
+	fillLocal(first, 1);
+	fillLocal(second, 2);
+	fillLocal(third, 3);
+	if (RepastProcess::instance()->rank() % 2 == 0) {
+		first.beginSynchronize();
+		second.beginSynchronize();
+		third.beginSynchronize();
+	} else {
+		third.beginSynchronize();
+		second.beginSynchronize();
+		first.beginSynchronize();
+	}
+	third.endSynchronize();
+	second.endSynchronize();
+	first.endSynchronize();
+	checkBuffers(first, global, 1, true, 1);
+	checkBuffers(second, global, 1, true, 2);
+	checkBuffers(third, global, 1, true, 3);
+}
+
+TEST(ValueLayerNDSync, DimensionOrdered2D)
+{
+	compareExchanges<ValueLayerND<double> >(2);
+	compareExchanges<ValueLayerNDSU<double> >(2);
+}
+
+TEST(ValueLayerNDSync, DimensionOrdered3D)
+{
+	compareExchanges<ValueLayerND<double> >(3);
+	compareExchanges<ValueLayerNDSU<double> >(3);
+}
+
+TEST(DiffusionLayerND, Stencils)
+{
+	for (int dims = 2; dims <= 3; dims++) {
+		VonNeumannDiffusor<double> vonNeumann(dims, 0.4, 0.1);
+		MooreDiffusor<double> moore(dims, 0.6, 0.05);
+		EvaporationDiffusor<double> evaporation(0.25);
+		for (int periodic = 0; periodic < 2; periodic++) {
+			compareDiffusion(dims, periodic, vonNeumann);
+			compareDiffusion(dims, periodic, moore);
+			compareDiffusion(dims, periodic, evaporation);
+		}
+	}
+}
+
+TEST(DiffusionLayerND, MooreConservesMass)
+{
+	// Without evaporation, diffusion in a periodic space moves mass but keeps the total
+	vector<int> procs = processDims(2);
+	GridDimensions global = globalBounds(procs);
+	DiffusionLayerND<double> layer(procs, global, 1, true, 0, 0);
+	fillLocal(layer, 0);
+	layer.synchronize();
+	MooreDiffusor<double> moore(2, 0.5);
+	for (int step = 0; step < 5; step++)
+		layer.diffuse(moore);
+
+	vector<int> min, max;
+	localBox(layer, 0, min, max);
+	vector<int> coords = min;
+	double total = 0, expected = 0;
+	bool err;
+	do {
+		total += layer.getValueAt(coords, err);
+		expected += cellValue(coords, 0);
+	} while (nextCoords(coords, min, max));
+	double globalTotal, globalExpected;
+	MPI_Allreduce(&total, &globalTotal, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+	MPI_Allreduce(&expected, &globalExpected, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+	ASSERT_NEAR(globalExpected, globalTotal, 1e-9 * globalExpected);
+}
+
+TEST(ValueLayerNDThreads, Diffusion)
+{
+	for (int dims = 1; dims <= 3; dims++) {
+		for (int periodic = 0; periodic < 2; periodic++) {
+			compareThreaded(dims, periodic, diffuseMooreCells);
+			compareThreaded(dims, periodic, diffuseMooreRows);
+		}
+	}
+}
+
+TEST(ValueLayerNDThreads, FromProps)
+{
+	Properties props;
+	initializeThreads(props);
+	ASSERT_EQ(1, getThreadCount());
+
+	props.putProperty(THREAD_COUNT_PROPERTY, "3");
+	initializeThreads(props);
+	ASSERT_EQ(3, getThreadCount());
+
+	props.putProperty(THREAD_COUNT_PROPERTY, "AUTO");
+	initializeThreads(props);
+	ASSERT_LE(1, getThreadCount());
+
+	props.putProperty(THREAD_COUNT_PROPERTY, "-2");
+	ASSERT_THROW(initializeThreads(props), Repast_Error_59);
+	setThreadCount(1);
+}
@@ -734,6 +734,91 @@ TEST_F(ObserverTests, PatchLocationTest)
 	ASSERT_EQ(4, nghs.size());
 }
 
+TEST_F(ObserverTests, PatchAtLocalBounds)
+{
+	// turtles start at the center, where every patch passed through on creation
+	obs->create<MyTurtle> (10);
+
+	GridDimensions dims = obs->grid()->dimensions();
+	for (int x = dims.origin(0); x < dims.origin(0) + dims.extents(0); ++x) {
+		for (int y = dims.origin(1); y < dims.origin(1) + dims.extents(1); ++y) {
+			Patch* patch = obs->patchAt(x, y);
+			ASSERT_TRUE(patch != 0);
+			ASSERT_EQ(x, patch->pxCor());
+			ASSERT_EQ(y, patch->pyCor());
+		}
+	}
+
+	// outside the world
+	ASSERT_TRUE(obs->patchAt(1000, 1000) == 0);
+}
+
+TEST_F(ObserverTests, PatchVariables)
+{
+	PatchVariable<int>* var = obs->createPatchVariable<int>("var", -1);
+	ASSERT_TRUE(obs->patchVariable<int>("var") == var);
+	ASSERT_TRUE(obs->patchVariable<double>("var") == 0);
+	ASSERT_TRUE(obs->patchVariable<int>("none") == 0);
+	ASSERT_THROW(obs->createPatchVariable<double>("var"), std::invalid_argument);
+
+	GridDimensions dims = obs->grid()->dimensions();
+	for (int x = dims.origin(0); x < dims.origin(0) + dims.extents(0); ++x) {
+		for (int y = dims.origin(1); y < dims.origin(1) + dims.extents(1); ++y) {
+			ASSERT_EQ(-1, var->get(x, y));
+			var->set(x, y, x * 1000 + y);
+			ASSERT_EQ(x * 1000 + y + 1, var->add(x, y, 1));
+		}
+	}
+
+	MyPatch* patch = obs->patchAt<MyPatch>(dims.origin(0), dims.origin(1));
+	ASSERT_EQ(dims.origin(0) * 1000 + dims.origin(1) + 1, patch->value(var));
+	patch->setValue(var, 7);
+	ASSERT_EQ(7, var->get(dims.origin(0), dims.origin(1)));
+	patch->setValue(var, dims.origin(0) * 1000 + dims.origin(1) + 1);
+
+	obs->synchronizePatchVariables();
+
+	// the buffer holds the neighbors' values, wrapping at the world's edges
+	for (int x = dims.origin(0) - 2; x < dims.origin(0) + dims.extents(0) + 2; ++x) {
+		for (int y = dims.origin(1) - 2; y < dims.origin(1) + dims.extents(1) + 2; ++y) {
+			int wx = (x + 50 + 102) % 102 - 50;
+			int wy = (y + 100 + 202) % 202 - 100;
+			ASSERT_EQ(wx * 1000 + wy + 1, var->get(x, y));
+			ASSERT_EQ(wx * 1000 + wy + 1, var->get(wx, wy));
+		}
+	}
+
+	ASSERT_THROW(var->get(dims.origin(0) - 3, dims.origin(1)), std::out_of_range);
+	ASSERT_THROW(var->set(dims.origin(0), dims.origin(1) + dims.extents(1) + 2, 0), std::out_of_range);
+}
+
+TEST_F(ObserverTests, PatchVariablesWithoutPatches)
+{
+	WorldDefinition def(-50, -100, 51, 101, false, 1);
+	def.setCreatePatches(false);
+	WorldCreator creator(RepastProcess::instance()->getCommunicator());
+	PatchCreator patchCreator;
+	Observer* noPatches = creator.createWorld<MyObserver, MyPatch> (def, std::vector<int>(2, 2), patchCreator);
+
+	ASSERT_EQ(0, noPatches->patches<MyPatch>().size());
+	GridDimensions dims = noPatches->grid()->dimensions();
+	ASSERT_TRUE(noPatches->patchAt(dims.origin(0), dims.origin(1)) == 0);
+
+	PatchVariable<double>* var = noPatches->createPatchVariable<double>("chemical");
+	for (int x = dims.origin(0); x < dims.origin(0) + dims.extents(0); ++x) {
+		for (int y = dims.origin(1); y < dims.origin(1) + dims.extents(1); ++y) {
+			var->set(x, y, x + y / 1000.0);
+		}
+	}
+	noPatches->synchronizePatchVariables();
+
+	// values from the neighbor along x
+	int x = dims.origin(0) == -50 ? dims.origin(0) + dims.extents(0) : dims.origin(0) - 1;
+	ASSERT_DOUBLE_EQ(x + dims.origin(1) / 1000.0, var->get(x, dims.origin(1)));
+
+	delete noPatches;
+}
+
 TEST_F(ObserverTests, GetXTests)
 {
 	obs->create<MyTurtle> (10);